@@ -0,0 +1,173 @@
+/*******************************************************************************
+	BQLList.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef BQLList_h
+#define BQLList_h
+
+#include <stddef.h>
+#include <pthread.h>
+#include "QLList.h"
+
+/*****************************************************************************//**
+  structure for a blocking que, a QLList behind a mutex that threads can
+  wait on
+
+ @param	list       the que
+ @param	high       pushes wait once the que holds this many items, 0 for no
+                   limit
+ @param	low        once pushes are waiting they carry on when the que is
+                   down to this many items
+ @param	full       non zero from when the que reaches high until it drains
+                   to low
+ @param	mutex      guards everything else
+ @param	readable   signaled when an item is pushed
+ @param	writable   signaled when the que drains to low
+
+  note:
+        the que must be set up with BQLList_init () before it is used
+        the list can have a pool, it is only touched with the mutex held
+*******************************************************************************/
+
+typedef struct {
+	QLList list;
+	size_t high;
+	size_t low;
+	int full;
+	pthread_mutex_t mutex;
+	pthread_cond_t readable;
+	pthread_cond_t writable;
+} BQLList;
+
+/*****************************************************************************//**
+	function to set up a blocking que
+
+ @param	list	the que
+ @param	high	the number of items pushes wait at, 0 for no limit
+ @param	low		the number of items waiting pushes carry on at, it must be
+					less than high
+
+ @return	0 on success
+				1 on error
+
+*******************************************************************************/
+
+int BQLList_init (
+	BQLList * list,
+	size_t high,
+	size_t low);
+
+/*****************************************************************************//**
+	function to push data onto a blocking que, waiting while it is full
+
+ @param	list	the que
+ @param	data	the data you wish to store in the que
+
+ @return	the data
+				NULL on error
+
+*******************************************************************************/
+
+void *BQLList_push (
+	BQLList * list,
+	void *data);
+
+/*****************************************************************************//**
+	function to pull data from a blocking que, waiting for some
+
+ @param	list	the que
+
+ @return	the data the node held
+
+*******************************************************************************/
+
+void *BQLList_pull (
+	BQLList * list);
+
+/*****************************************************************************//**
+	function to pull data from a blocking que, waiting for some no longer than
+	a timeout
+
+ @param	list	the que
+ @param	msec	the most milliseconds to wait, 0 to not wait, less than 0 to
+					wait for ever
+
+ @return	the data the node held
+				NULL if the timeout passed with the que empty
+
+*******************************************************************************/
+
+void *BQLList_pull_timed (
+	BQLList * list,
+	long msec);
+
+/*****************************************************************************//**
+	function to pull up to a number of items from a blocking que under one
+	lock
+
+ @param	list	the que
+ @param	array	the array to fill, in the order the items were pushed
+ @param	max		the most items to pull
+ @param	msec	the most milliseconds to wait for the first item, 0 to not
+					wait, less than 0 to wait for ever
+
+ @return	the number of items pulled
+				0 if the timeout passed with the que empty
+
+*******************************************************************************/
+
+size_t BQLList_pull_batch (
+	BQLList * list,
+	void **array,
+	size_t max,
+	long msec);
+
+/*****************************************************************************//**
+	function to count the items in a blocking que
+
+ @param	list	the que
+
+ @return	the number of items in the que
+
+*******************************************************************************/
+
+size_t BQLList_length (
+	BQLList * list);
+
+/*****************************************************************************//**
+	function to delete all the items in a blocking que and tear it down
+
+ @param	list		the que
+ @param	function	the function to call to free the data, or NULL
+
+ @return	nothing
+
+  note:
+        no thread may be waiting on the que, it must be set up with
+        BQLList_init () again before it is used again
+*******************************************************************************/
+
+void BQLList_delete_all (
+	BQLList * list,
+	QLList_data_free_func function);
+
+#endif
@@ -0,0 +1,302 @@
+/*******************************************************************************
+	CHTable.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef CHTable_h
+#define CHTable_h
+
+#include <stddef.h>
+#include <pthread.h>
+#include "LLPool.h"
+
+/*****************************************************************************//**
+  number of shards in a concurrent hash table, a power of 2, each shard has
+  its own lock so threads working on different shards do not wait for each
+  other
+*******************************************************************************/
+
+#define CHTABLE_SHARDS 64
+
+/*****************************************************************************//**
+  number of buckets a shard starts with
+*******************************************************************************/
+
+#define CHTABLE_BUCKETS 16
+
+/*****************************************************************************//**
+  number of buckets of the old table each write moves while a shard is
+  growing
+*******************************************************************************/
+
+#define CHTABLE_MIGRATE 4
+
+/*****************************************************************************//**
+  size of a cache line, each shard starts on its own line so the locks of
+  two shards do not share one
+*******************************************************************************/
+
+#define CHTABLE_CACHELINE 64
+
+/*****************************************************************************//**
+  structure for an entry in a concurrent hash table
+
+ @param	next  the next entry in the bucket
+ @param	hash  the hash of the data
+ @param	data  the data
+*******************************************************************************/
+
+typedef struct CHTable_node_tab {
+	struct CHTable_node_tab *next;
+	size_t hash;
+	void *data;
+} CHTable_node;
+
+/*****************************************************************************//**
+  structure for a shard of a concurrent hash table
+
+ @param	lock     readers share it, writers take it alone
+ @param	length   the number of entries in the shard
+ @param	size     the number of buckets in table, a power of 2
+ @param	table    the buckets
+ @param	oldsize  the number of buckets in old
+ @param	old      the buckets being moved to table while the shard grows, or
+                 NULL
+ @param	moved    the number of buckets of old already moved
+ @param	pool     the pool the entries are taken from
+
+  note:
+        growing never stops the shard, each write moves a few buckets of the
+        old table until it is empty, entries for an old bucket not moved yet
+        are kept there, new ones too, so a hash is only ever in one bucket
+*******************************************************************************/
+
+typedef struct {
+	pthread_rwlock_t lock;
+	size_t length;
+	size_t size;
+	CHTable_node **table;
+	size_t oldsize;
+	CHTable_node **old;
+	size_t moved;
+	LLPool pool;
+} __attribute__ ((aligned (CHTABLE_CACHELINE))) CHTable_shard;
+
+/*****************************************************************************//**
+  type of function to pass to hash data
+
+ @param	data  the data
+
+ @return	the hash of the data
+
+  note:
+        data that compares equal must hash the same
+        the hash is mixed again by the table so a weak hash is fine
+*******************************************************************************/
+
+typedef size_t (*CHTable_data_hash_func) (
+  void *data);
+
+/*****************************************************************************//**
+  type of function to pass to compare data
+
+ @param	data1   the first data pointer to be compared
+ @param	data2   the second data pointer to be compared
+
+ @return	0 if data1 is equal to data2
+ @return	non zero if they are not equal
+
+   note
+        if data is a char pointer strcmp() can be passed
+*******************************************************************************/
+
+typedef int (*CHTable_data_cmp_func) (
+  void *data1,
+  void *data2);
+
+/*****************************************************************************//**
+  type of a function to pass to the delete functions to free the data
+
+ @param	data  pointer to the data to be free'ed
+
+ @return	nothing
+
+  note:
+        free() can be used if the data is a simple type
+*******************************************************************************/
+
+typedef void (*CHTable_data_free_func) (
+  void *data);
+
+/*****************************************************************************//**
+  structure for a concurrent hash table, the data is spread over shards by
+  hash and each shard is a chained hash table behind a reader writer lock
+
+ @param	hash   function to hash the data
+ @param	cmp    function to compare the data
+ @param	free   function to free the data, or NULL
+ @param	shard  the shards
+
+  note:
+        set hash, cmp and free then call CHTable_init () before the table
+        is used
+*******************************************************************************/
+
+typedef struct {
+	CHTable_data_hash_func hash;
+	CHTable_data_cmp_func cmp;
+	CHTable_data_free_func free;
+	CHTable_shard shard[CHTABLE_SHARDS];
+} CHTable;
+
+/*****************************************************************************//**
+  type of function to be passed to the iterate function
+
+ @param	table  the table being parsed
+ @param	data   the current data
+ @param	extra  the extra pointer passed to the itterate function
+
+ @return	null to continue the itterate loop
+          non null that stops the itterate loop and is returned by the iterate
+          function
+
+  note:
+        the function is called with the shard's lock held for reading, it
+        must not change the table
+*******************************************************************************/
+
+typedef void *(*CHTable_iterate_func) (
+	CHTable *table,
+	void *data,
+	void *extra);
+
+/*****************************************************************************//**
+	function to set up a concurrent hash table
+
+ @param	table	the table, with hash, cmp and free set
+
+ @return	0 on success
+				1 on error
+
+*******************************************************************************/
+
+int CHTable_init (
+	CHTable * table);
+
+/*****************************************************************************//**
+	function to find data in a concurrent hash table
+
+ @param	table	the table
+ @param	data	data equal to the data to find
+
+ @return	the data in the table
+				NULL if it is not in the table
+
+  note:
+        the data can be deleted by another thread once this returns, the
+        caller has to keep it alive some other way if that can happen
+*******************************************************************************/
+
+void *CHTable_find (
+	CHTable * table,
+	void *data);
+
+/*****************************************************************************//**
+	function to insert data in a concurrent hash table
+
+ @param	table	the table
+ @param	data	the data to insert
+
+ @return	the data in the table, if equal data was already there it is
+				returned and data is not inserted
+				NULL on error
+
+*******************************************************************************/
+
+void *CHTable_insert (
+	CHTable * table,
+	void *data);
+
+/*****************************************************************************//**
+	function to delete data from a concurrent hash table
+
+ @param	table	the table
+ @param	data	data equal to the data to delete
+
+ @return	the data that was in the table, it is not passed to table->free
+				NULL if it is not in the table
+
+*******************************************************************************/
+
+void *CHTable_delete (
+	CHTable * table,
+	void *data);
+
+/*****************************************************************************//**
+	function to count the data in a concurrent hash table
+
+ @param	table	the table
+
+ @return	the number of data in the table
+
+  note:
+        with other threads writing the count is only a snapshot
+*******************************************************************************/
+
+size_t CHTable_length (
+	CHTable * table);
+
+/*****************************************************************************//**
+	function to iterate a concurrent hash table a shard at a time
+
+ @param	table 		the table
+ @param	function	the function to pass each data to for processing
+ @param	extra		extra data to pass to/from the proccessing function
+
+ @return	the non null returned from the proccessing function that stops the
+			iteration
+			NULL if the end of the table was reached
+
+*******************************************************************************/
+
+void *CHTable_iterate (
+	CHTable * table,
+	CHTable_iterate_func function,
+	void *extra);
+
+/*****************************************************************************//**
+	function to delete all the data in a concurrent hash table and tear it
+	down
+
+ @param	table	the table
+
+ @return	nothing
+
+  note:
+        table->free is called for each data if it is set
+        no other thread may be using the table, it must be set up with
+        CHTable_init () again before it is used again
+*******************************************************************************/
+
+void CHTable_delete_all (
+	CHTable * table);
+
+#endif
@@ -24,6 +24,9 @@
 #ifndef CLList_h
 #define CLList_h
 
+#include "LLPool.h"
+#include "LLArena.h"
+
 typedef struct CLList_node_tab {
 	struct CLList_node_tab *prev;
 	struct CLList_node_tab *next;
@@ -34,6 +37,7 @@ typedef struct {
 	size_t length;
 	CLList_node *head;
 	CLList_node *tail;
+	LLPool *pool;
 } CLList;
 
 /*****************************************************************************//**
@@ -88,6 +92,28 @@ typedef void *(*CLList_data_copy_func) (
   void **dest,
   void *src);
 
+
+/*****************************************************************************//**
+  type of function to pass to the arena copy functions
+
+ @param	dest   pointer to the new data pointer
+ @param	src    the data pointer in the node to be copyed
+ @param	arena  the arena passed to the copy function, or NULL, the copy can be
+               allocated from it
+
+ @return	the new copyed data
+        NULL on error
+
+  note:
+        with an arena the copies do not need a free function, a failed copy
+        gives the arena back to where it was
+*******************************************************************************/
+
+typedef void *(*CLList_data_arena_copy_func) (
+  void **dest,
+  void *src,
+  LLArena *arena);
+
 /*****************************************************************************//**
 	function to add a node to the tail of a circular linked list
 	
@@ -419,5 +445,78 @@ CLList_node *CLList_insert_list_before_copy (
 	CLList_node * node,
 	CLList_data_copy_func copy_func);
 
+/*****************************************************************************//**
+	function to add the data in an array to the tail of a circular linked list
+
+ @param	list	the linked list
+ @param	array	the data you wish to store in the linked list
+ @param	count	the number of entries in the array
+
+ @return	0 on success
+				1 on error, nothing is added
+
+	notes:
+				the same as appending each entry in turn, array[count - 1] becomes
+				the tail
+				with a pool all the nodes are taken from one block
+
+*******************************************************************************/
+
+int CLList_append_array (
+	CLList * list,
+	void **array,
+	size_t count);
+
+/*****************************************************************************//**
+	function to copy the data in a circular linked list to an array
+
+ @param	list	the linked list
+ @param	array	the array to fill, it must have room for the length of the list
+
+ @return	the number of entries filled in
+
+	notes:
+				the array is filled once round the circle starting at the head
+
+*******************************************************************************/
+
+size_t CLList_to_array (
+	CLList * list,
+	void **array);
+
+
+/*****************************************************************************//**
+	function to copy another list to the tail of a circular linked list, all or
+	nothing
+
+ @param	dest		the linked list you want to copy the src to
+ @param	src			the linked list you want to copy to the dest
+ @param	copy_func	function to copy the data held in each node
+ @param	free_func	function to free the copies made if a later one fails,
+						or NULL
+ @param	arena		the arena to pass to copy_func, or NULL
+
+ @return	0 on success
+				1 on error, nothing is added
+
+	notes:
+				every copy is made before any node is added, then the nodes are
+				added at once like CLList_append_array ()
+				the nodes are only one block when dest->pool is set, without
+				a pool each node is malloced on its own as it is freed on its
+				own, the copy is still all or nothing
+				on failure the copies are passed to free_func and the arena is
+				released back to where it was
+				you can cast a QLList, DQLList or DLList to CLList for the src
+				argument
+
+*******************************************************************************/
+
+int CLList_append_list_copy_arena (
+	CLList * dest,
+	CLList * src,
+	CLList_data_arena_copy_func copy_func,
+	CLList_data_free_func free_func,
+	LLArena * arena);
 
 #endif
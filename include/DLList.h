@@ -24,6 +24,9 @@
 #ifndef DLList_h
 #define DLList_h
 
+#include "LLPool.h"
+#include "LLArena.h"
+
 typedef struct DLList_node_tab {
 	struct DLList_node_tab *prev;
 	struct DLList_node_tab *next;
@@ -34,6 +37,7 @@ typedef struct {
 	size_t length;
 	DLList_node *head;
 	DLList_node *tail;
+	LLPool *pool;
 } DLList;
 
 /*****************************************************************************//**
@@ -88,6 +92,28 @@ typedef void *(*DLList_data_copy_func) (
   void **dest,
   void *src);
 
+
+/*****************************************************************************//**
+  type of function to pass to the arena copy functions
+
+ @param	dest   pointer to the new data pointer
+ @param	src    the data pointer in the node to be copyed
+ @param	arena  the arena passed to the copy function, or NULL, the copy can be
+               allocated from it
+
+ @return	the new copyed data
+        NULL on error
+
+  note:
+        with an arena the copies do not need a free function, a failed copy
+        gives the arena back to where it was
+*******************************************************************************/
+
+typedef void *(*DLList_data_arena_copy_func) (
+  void **dest,
+  void *src,
+  LLArena *arena);
+
 /*****************************************************************************//**
   type of function to pass to the mergesort to compare the data
   
@@ -106,6 +132,35 @@ typedef int (*DLList_data_cmp_func) (
   void *data1,
   void *data2);
 
+/*****************************************************************************//**
+  type of function to pass to the radix sort to get the integer key of the data
+
+ @param	data    the data pointer
+
+ @return	the key, the list is sorted by it in ascending order
+*******************************************************************************/
+
+typedef unsigned long long (*DLList_data_key_func) (
+  void *data);
+
+/*****************************************************************************//**
+  type of function to pass to the compact function to learn where each node
+  moved to
+
+ @param	list  the list being compacted
+ @param	old   the node as it was, still readable
+ @param	new   the node that replaces it
+ @param	extra the extra pointer passed to the compact function
+
+ @return	nothing
+*******************************************************************************/
+
+typedef void (*DLList_node_move_func) (
+  DLList *list,
+  DLList_node *old,
+  DLList_node *new,
+  void *extra);
+
 /*****************************************************************************//**
 	function to add a node to the head of a double linked list
 	
@@ -258,6 +313,10 @@ void *DLList_iterate (
 
  @return	nothing
 
+  note:
+        if the list has a pool and this returns the last node the pool handed
+        out, the pool's slabs are released
+
 *******************************************************************************/
 
 void DLList_delete_all (
@@ -442,4 +501,259 @@ void DLList_sort (
 	DLList * list,
 	DLList_data_cmp_func cmp_func);
 
+/*****************************************************************************//**
+	function to sort a double linked list, taking advantage of runs already in
+	the list
+
+ @param	list		the linked list to sort
+ @param	cmp_func	function to compare the data in 2 nodes
+
+ @return	nothing
+
+	Notes:
+				ascending and strictly descending runs are merged TimSort style with
+				galloping, a sorted or reversed list costs length - 1 compares
+				the sort is stable
+
+*******************************************************************************/
+
+void DLList_sort_adaptive (
+	DLList * list,
+	DLList_data_cmp_func cmp_func);
+
+/*****************************************************************************//**
+	the fewest nodes each thread of DLList_sort_parallel () is given
+*******************************************************************************/
+
+#define DLLIST_SORT_PARALLEL_MIN 16384
+
+/*****************************************************************************//**
+	function to sort a double linked list with several threads
+
+ @param	list		the linked list to sort
+ @param	cmp_func	function to compare the data in 2 nodes
+ @param	threads		the most threads to use, including the calling thread
+
+ @return	nothing
+
+	Notes:
+				the list is cut into one segment per thread, each segment is sorted
+				with the adaptive sort and the sorted segments are merged in pairs
+				with every merge, the last one too, split across all the threads
+				if the 2 arrays of length pointers that takes can not be allocated
+				the merges of a round run in parallel but the last one is serial
+				fewer threads are used so each gets at least
+				DLLIST_SORT_PARALLEL_MIN nodes, if that leaves one thread the
+				list is sorted in the calling thread with DLList_sort_adaptive ()
+				cmp_func is called from several threads at once and must be thread
+				safe
+				the sort is stable
+
+*******************************************************************************/
+
+void DLList_sort_parallel (
+	DLList * list,
+	DLList_data_cmp_func cmp_func,
+	size_t threads);
+
+/*****************************************************************************//**
+	function to sort a double linked list in an array
+
+ @param	list		the linked list to sort
+ @param	cmp_func	function to compare the data in 2 nodes
+ @param	relocate	non zero to move the data between the nodes instead of
+									moving the nodes
+
+ @return	0 on success
+				1 if out of memory, the list is left as it was
+
+	Notes:
+				the nodes are gathered into an array, introsorted and relinked in
+				one pass, the sort is not stable
+				with relocate the nodes are relinked in address order and the data
+				is moved into them sorted, walking the list then walks memory
+				forward, best with a pool, but node pointers held elsewhere no
+				longer hold the same data
+
+*******************************************************************************/
+
+int DLList_sort_array (
+	DLList * list,
+	DLList_data_cmp_func cmp_func,
+	int relocate);
+
+/*****************************************************************************//**
+	function to sort a double linked list by an integer key with a radix sort
+
+ @param	list		the linked list to sort
+ @param	key_func	function to get the key of the data in a node
+
+ @return	nothing
+
+	Notes:
+				an LSD radix sort one byte of the key at a time, linear time and
+				stable, bytes that are the same in every key cost no pass
+				nothing is allocated
+
+*******************************************************************************/
+
+void DLList_sort_radix (
+	DLList * list,
+	DLList_data_key_func key_func);
+
+/*****************************************************************************//**
+	function to add the data in an array to the tail of a double linked list
+
+ @param	list	the linked list
+ @param	array	the data you wish to store in the linked list
+ @param	count	the number of entries in the array
+
+ @return	0 on success
+				1 on error, nothing is added
+
+	notes:
+				array[0] ends up nearest the head, as if each was appended in turn
+				with a pool all the nodes are taken from one block
+
+*******************************************************************************/
+
+int DLList_append_array (
+	DLList * list,
+	void **array,
+	size_t count);
+
+/*****************************************************************************//**
+	function to add the data in an array to the head of a double linked list
+
+ @param	list	the linked list
+ @param	array	the data you wish to store in the linked list
+ @param	count	the number of entries in the array
+
+ @return	0 on success
+				1 on error, nothing is added
+
+	notes:
+				array[count - 1] ends up at the head, as if each was prepended in
+				turn
+				with a pool all the nodes are taken from one block
+
+*******************************************************************************/
+
+int DLList_prepend_array (
+	DLList * list,
+	void **array,
+	size_t count);
+
+/*****************************************************************************//**
+	function to copy the data in a double linked list to an array
+
+ @param	list	the linked list
+ @param	array	the array to fill, it must have room for the length of the list
+
+ @return	the number of entries filled in
+
+	notes:
+				the array is filled from the head to the tail
+
+*******************************************************************************/
+
+size_t DLList_to_array (
+	DLList * list,
+	void **array);
+
+/*****************************************************************************//**
+	function to move the nodes of a double linked list next to each other in
+	the order they are linked
+
+ @param	list		the linked list
+ @param	function	function to call for each node moved, or NULL
+ @param	extra		extra data to pass to the function
+
+ @return	0 on success
+				1 on error, the list is left as it was
+
+	Notes:
+				every node is replaced by a new one holding the same data and the
+				old node is freed, node pointers held elsewhere must be updated
+				through function, which is called before each old node is freed
+				with a pool the new nodes are one block, without one they are
+				malloced in order and how close they land is up to malloc
+
+*******************************************************************************/
+
+int DLList_compact (
+	DLList * list,
+	DLList_node_move_func function,
+	void *extra);
+
+
+/*****************************************************************************//**
+	function to copy another list to the tail of a double linked list, all or
+	nothing
+
+ @param	dest		the linked list you want to copy the src to
+ @param	src			the linked list you want to copy to the dest
+ @param	copy_func	function to copy the data held in each node
+ @param	free_func	function to free the copies made if a later one fails,
+						or NULL
+ @param	arena		the arena to pass to copy_func, or NULL
+
+ @return	0 on success
+				1 on error, nothing is added
+
+	notes:
+				every copy is made before any node is added, then the nodes are
+				added at once like DLList_append_array ()
+				the nodes are only one block when dest->pool is set, without
+				a pool each node is malloced on its own as it is freed on its
+				own, the copy is still all or nothing
+				on failure the copies are passed to free_func and the arena is
+				released back to where it was
+				you can cast a CLList, QLList, or DQLList to DLList for the src
+				argument
+
+*******************************************************************************/
+
+int DLList_append_list_copy_arena (
+	DLList * dest,
+	DLList * src,
+	DLList_data_arena_copy_func copy_func,
+	DLList_data_free_func free_func,
+	LLArena * arena);
+
+/*****************************************************************************//**
+	function to copy another list to the head of a double linked list, all or
+	nothing
+
+ @param	dest		the linked list you want to copy the src to
+ @param	src			the linked list you want to copy to the dest
+ @param	copy_func	function to copy the data held in each node
+ @param	free_func	function to free the copies made if a later one fails,
+						or NULL
+ @param	arena		the arena to pass to copy_func, or NULL
+
+ @return	0 on success
+				1 on error, nothing is added
+
+	notes:
+				every copy is made before any node is added, then the nodes are
+				added at once like DLList_prepend_array ()
+				the nodes are only one block when dest->pool is set, without
+				a pool each node is malloced on its own as it is freed on its
+				own, the copy is still all or nothing
+				on failure the copies are passed to free_func and the arena is
+				released back to where it was
+				you can cast a CLList, QLList, or DQLList to DLList for the src
+				argument
+				the src keeps its order, its head becomes the head of dest
+
+*******************************************************************************/
+
+int DLList_prepend_list_copy_arena (
+	DLList * dest,
+	DLList * src,
+	DLList_data_arena_copy_func copy_func,
+	DLList_data_free_func free_func,
+	LLArena * arena);
+
 #endif
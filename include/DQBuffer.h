@@ -0,0 +1,222 @@
+/*******************************************************************************
+	DQBuffer.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef DQBuffer_h
+#define DQBuffer_h
+
+#include <stddef.h>
+
+/*****************************************************************************//**
+  number of slots a deque buffer starts with
+*******************************************************************************/
+
+#define DQBUFFER_SIZE 16
+
+/*****************************************************************************//**
+  structure for a deque kept in a ring buffer, the array backed twin of
+  DQLList
+
+ @param	length  the number of items in the deque
+ @param	size    the number of slots, always a power of 2 once allocated
+ @param	first   the slot holding the head
+ @param	buffer  the slots
+
+  note:
+        a zero filled DQBuffer is a valid empty deque
+        the buffer doubles when it is full and is only freed by
+        DQBuffer_delete_all (), so a deque that stays about the same size
+        allocates nothing once it has grown
+*******************************************************************************/
+
+typedef struct {
+	size_t length;
+	size_t size;
+	size_t first;
+	void **buffer;
+} DQBuffer;
+
+/*****************************************************************************//**
+  type of function to be passed to the iterate function
+
+ @param	list   the deque being parsed
+ @param	index  the position of the current item, 0 is the head
+ @param	data   the current item
+ @param	extra  the extra pointer passed to the itterate function
+
+ @return	null to continue the itterate loop
+          non null that stops the itterate loop and is returned by the iterate
+          function
+*******************************************************************************/
+
+typedef void *(*DQBuffer_iterate_func) (
+	DQBuffer *list,
+	size_t index,
+	void *data,
+	void *extra);
+
+/*****************************************************************************//**
+  type of a function to pass to the delete functions to free the data
+
+ @param	data  pointer to the data to be free'ed
+
+ @return	nothing
+
+  note:
+        free() can be used if the data is a simple type
+*******************************************************************************/
+
+typedef void (*DQBuffer_data_free_func) (
+  void *data);
+
+/*****************************************************************************//**
+	function to push data onto the head of a deque
+
+ @param	list	the deque
+ @param	data	the data you wish to store in the deque
+
+ @return	the data
+				NULL on error
+
+*******************************************************************************/
+
+void *DQBuffer_push (
+	DQBuffer * list,
+	void *data);
+
+/*****************************************************************************//**
+	function to pull data from the tail of a deque
+
+ @param	list	the deque
+
+ @return	the data
+				NULL if the deque is empty
+
+*******************************************************************************/
+
+void *DQBuffer_pull (
+	DQBuffer * list);
+
+/*****************************************************************************//**
+	function to pop data from the head of a deque
+
+ @param	list	the deque
+
+ @return	the data
+				NULL if the deque is empty
+
+*******************************************************************************/
+
+void *DQBuffer_pop (
+	DQBuffer * list);
+
+/*****************************************************************************//**
+	function to read the tail of a deque without pulling it
+
+ @param	list	the deque
+
+ @return	the data
+				NULL if the deque is empty
+
+*******************************************************************************/
+
+void *DQBuffer_read_tail (
+	DQBuffer * list);
+
+/*****************************************************************************//**
+	function to read the head of a deque without popping it
+
+ @param	list	the deque
+
+ @return	the data
+				NULL if the deque is empty
+
+*******************************************************************************/
+
+void *DQBuffer_read_head (
+	DQBuffer * list);
+
+/*****************************************************************************//**
+	function to count the items in a deque
+
+ @param	list	the deque
+
+ @return	the number of items in the deque
+
+*******************************************************************************/
+
+size_t DQBuffer_length (
+	DQBuffer * list);
+
+/*****************************************************************************//**
+	function to iterate a deque from the head to the tail
+
+ @param	list 		the deque
+ @param	function	the function to pass each item to for processing
+ @param	extra		extra data to pass to/from the proccessing function
+
+ @return	the non null returned from the proccessing function that stops the
+				iteration
+				NULL if the end of the deque was reached
+
+  note:
+        the deque must not be changed during the iteration
+*******************************************************************************/
+
+void *DQBuffer_iterate (
+	DQBuffer * list,
+	DQBuffer_iterate_func function,
+	void *extra);
+
+/*****************************************************************************//**
+	function to delete all the items in a deque and free its buffer
+
+ @param	list		the deque
+ @param	function	the function to call to free the data, or NULL
+
+ @return	nothing
+
+*******************************************************************************/
+
+void DQBuffer_delete_all (
+	DQBuffer * list,
+	DQBuffer_data_free_func function);
+
+/*****************************************************************************//**
+	function to move another deque to the head of a deque
+
+ @param	dest	the deque you want to move the src to
+ @param	src		the deque you want to move to the dest
+
+ @return	0 on success
+				1 on error, nothing is moved
+
+  note:
+        the src keeps its order, its tail ends up next to the old head of
+        the dest, the src is left empty but keeps its buffer
+*******************************************************************************/
+
+int DQBuffer_push_list (
+	DQBuffer * dest,
+	DQBuffer * src);
+
+#endif
@@ -26,6 +26,9 @@
 #ifndef DQLList_h
 #define DQLList_h
 
+#include "LLPool.h"
+#include "LLArena.h"
+
 typedef struct DQLList_node_tab {
 	struct DQLList_node_tab *prev;
 	struct DQLList_node_tab *next;
@@ -36,6 +39,7 @@ typedef struct {
 	size_t length;
 	DQLList_node *head;
 	DQLList_node *tail;
+	LLPool *pool;
 } DQLList;
 
 /*****************************************************************************//**
@@ -91,6 +95,28 @@ typedef void *(*DQLList_data_copy_func) (
   void *src);
 
 
+/*****************************************************************************//**
+  type of function to pass to the arena copy functions
+
+ @param	dest   pointer to the new data pointer
+ @param	src    the data pointer in the node to be copyed
+ @param	arena  the arena passed to the copy function, or NULL, the copy can be
+               allocated from it
+
+ @return	the new copyed data
+        NULL on error
+
+  note:
+        with an arena the copies do not need a free function, a failed copy
+        gives the arena back to where it was
+*******************************************************************************/
+
+typedef void *(*DQLList_data_arena_copy_func) (
+  void **dest,
+  void *src,
+  LLArena *arena);
+
+
 
 
 
@@ -233,4 +259,78 @@ DQLList_node *DQLList_push_list_copy (
 	DQLList * src,
 	DQLList_data_copy_func func);
 
+/*****************************************************************************//**
+	function to push the data in an array onto a deque
+
+ @param	list	the linked list
+ @param	array	the data you wish to store in the linked list
+ @param	count	the number of entries in the array
+
+ @return	0 on success
+				1 on error, nothing is pushed
+
+	notes:
+				the same as pushing each entry in turn, array[0] is pulled first
+				with a pool all the nodes are taken from one block
+
+*******************************************************************************/
+
+int DQLList_push_array (
+	DQLList * list,
+	void **array,
+	size_t count);
+
+/*****************************************************************************//**
+	function to copy the data in a deque to an array
+
+ @param	list	the linked list
+ @param	array	the array to fill, it must have room for the length of the list
+
+ @return	the number of entries filled in
+
+	notes:
+				the array is filled from the tail to the head, the order the data
+				would be pulled in
+
+*******************************************************************************/
+
+size_t DQLList_to_array (
+	DQLList * list,
+	void **array);
+
+
+/*****************************************************************************//**
+	function to copy another list to the head of a deque, all or nothing
+
+ @param	dest		the linked list you want to copy the src to
+ @param	src			the linked list you want to copy to the dest
+ @param	copy_func	function to copy the data held in each node
+ @param	free_func	function to free the copies made if a later one fails,
+						or NULL
+ @param	arena		the arena to pass to copy_func, or NULL
+
+ @return	0 on success
+				1 on error, nothing is added
+
+	notes:
+				every copy is made before any node is added, then the nodes are
+				added at once like DQLList_push_array ()
+				the nodes are only one block when dest->pool is set, without
+				a pool each node is malloced on its own as it is freed on its
+				own, the copy is still all or nothing
+				on failure the copies are passed to free_func and the arena is
+				released back to where it was
+				you can cast a DLList, CLList, or QLList to DQLList for the src
+				argument
+				the src keeps its order, its head becomes the head of dest
+
+*******************************************************************************/
+
+int DQLList_push_list_copy_arena (
+	DQLList * dest,
+	DQLList * src,
+	DQLList_data_arena_copy_func copy_func,
+	DQLList_data_free_func free_func,
+	LLArena * arena);
+
 #endif
@@ -0,0 +1,265 @@
+/*******************************************************************************
+	HTable.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef HTable_h
+#define HTable_h
+
+#include <stddef.h>
+
+/*****************************************************************************//**
+  number of slots in a group, the slots are probed a group at a time and the
+  table is always a whole number of groups
+*******************************************************************************/
+
+#define HTABLE_GROUP 16
+
+/*****************************************************************************//**
+  type of function to pass to hash data
+
+ @param	data  the data
+
+ @return	the hash of the data
+
+  note:
+        data that compares equal must hash the same
+        the hash is mixed again by the table so a weak hash such as the
+        value of an integer key is fine
+        LLCache_hash_string () can be passed if the data is a char pointer
+*******************************************************************************/
+
+typedef size_t (*HTable_data_hash_func) (
+  void *data);
+
+/*****************************************************************************//**
+  type of function to pass to compare data
+
+ @param	data1   the first data pointer to be compared
+ @param	data2   the second data pointer to be compared
+
+ @return	0 if data1 is equal to data2
+ @return	non zero if they are not equal
+
+   note
+        if data is a char pointer strcmp() can be passed
+*******************************************************************************/
+
+typedef int (*HTable_data_cmp_func) (
+  void *data1,
+  void *data2);
+
+/*****************************************************************************//**
+  type of a function to pass to the delete functions to free the data
+
+ @param	data  pointer to the data to be free'ed
+
+ @return	nothing
+
+  note:
+        free() can be used if the data is a simple type
+*******************************************************************************/
+
+typedef void (*HTable_data_free_func) (
+  void *data);
+
+/*****************************************************************************//**
+  structure for an open addressing hash table, each slot has a control byte
+  holding 7 bits of its data's hash, or a mark for an empty or deleted slot,
+  and a lookup compares the control bytes of a whole group at once
+
+ @param	length  the number of data in the table
+ @param	size    the number of slots, a power of 2 and a whole number of groups
+ @param	left    the number of empty slots that can be filled before the table
+                is rehashed
+ @param	slot    the data in each slot
+ @param	ctrl    the control byte of each slot
+ @param	hash    function to hash the data
+ @param	cmp     function to compare the data
+ @param	free    function to free the data, or NULL
+
+  note:
+        a zero filled HTable with hash and cmp set is a valid empty table
+        to use it as a map store a structure holding the key and the value
+        and look it up with a structure holding just the key
+*******************************************************************************/
+
+typedef struct {
+	size_t length;
+	size_t size;
+	size_t left;
+	void **slot;
+	unsigned char *ctrl;
+	HTable_data_hash_func hash;
+	HTable_data_cmp_func cmp;
+	HTable_data_free_func free;
+} HTable;
+
+/*****************************************************************************//**
+  type of function to be passed to the iterate function
+
+ @param	table  the table being parsed
+ @param	data   the current data
+ @param	extra  the extra pointer passed to the itterate function
+
+ @return	null to continue the itterate loop
+          non null that stops the itterate loop and is returned by the iterate
+          function
+
+  note:
+        the current data can be deleted from the table
+*******************************************************************************/
+
+typedef void *(*HTable_iterate_func) (
+	HTable *table,
+	void *data,
+	void *extra);
+
+/*****************************************************************************//**
+	function to find data in a hash table
+
+ @param	table	the table
+ @param	data	data equal to the data to find
+
+ @return	the data in the table
+				NULL if it is not in the table
+
+*******************************************************************************/
+
+void *HTable_find (
+	HTable * table,
+	void *data);
+
+/*****************************************************************************//**
+	function to insert data in a hash table
+
+ @param	table	the table
+ @param	data	the data to insert
+
+ @return	the data in the table, if equal data was already there it is
+				returned and data is not inserted
+				NULL on error
+
+*******************************************************************************/
+
+void *HTable_insert (
+	HTable * table,
+	void *data);
+
+/*****************************************************************************//**
+	function to delete data from a hash table
+
+ @param	table	the table
+ @param	data	data equal to the data to delete
+
+ @return	the data that was in the table, it is not passed to table->free
+				NULL if it is not in the table
+
+*******************************************************************************/
+
+void *HTable_delete (
+	HTable * table,
+	void *data);
+
+/*****************************************************************************//**
+	function to count the data in a hash table
+
+ @param	table	the table
+
+ @return	the number of data in the table
+
+*******************************************************************************/
+
+size_t HTable_length (
+	HTable * table);
+
+/*****************************************************************************//**
+	function to make room in a hash table so it can hold a number of data
+	without rehashing
+
+ @param	table	the table
+ @param	count	the number of data the table must hold
+
+ @return	0 on success
+				1 on error, the table is left as it was
+
+*******************************************************************************/
+
+int HTable_reserve (
+	HTable * table,
+	size_t count);
+
+/*****************************************************************************//**
+	function to rebuild a hash table with room for a number of data, dropping
+	the marks deleted data left behind
+
+ @param	table	the table
+ @param	count	the number of data the table must hold, less than the
+					length is taken as the length
+
+ @return	0 on success
+				1 on error, the table is left as it was
+
+  note:
+        this can make the table smaller, HTable_rehash (table, 0) shrinks it
+        to fit
+*******************************************************************************/
+
+int HTable_rehash (
+	HTable * table,
+	size_t count);
+
+/*****************************************************************************//**
+	function to iterate a hash table
+
+ @param	table 		the table
+ @param	function	the function to pass each data to for processing
+ @param	extra		extra data to pass to/from the proccessing function
+
+ @return	the non null returned from the proccessing function that stops the
+			iteration
+			NULL if the end of the table was reached
+
+  note:
+        the order is the order of the slots, not the order of insertion
+        nothing may be inserted during the iteration
+*******************************************************************************/
+
+void *HTable_iterate (
+	HTable * table,
+	HTable_iterate_func function,
+	void *extra);
+
+/*****************************************************************************//**
+	function to delete all the data in a hash table and free its slots
+
+ @param	table	the table
+
+ @return	nothing
+
+  note:
+        table->free is called for each data if it is set
+*******************************************************************************/
+
+void HTable_delete_all (
+	HTable * table);
+
+#endif
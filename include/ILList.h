@@ -0,0 +1,300 @@
+/*******************************************************************************
+	ILList.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef ILList_h
+#define ILList_h
+
+#include <stddef.h>
+
+/*****************************************************************************//**
+  structure for the links of an intrusive double linked list, embed one in your
+  own structure for each list it can be on
+
+ @param	prev  the previous link in the list
+ @param	next  the next link in the list
+*******************************************************************************/
+
+typedef struct ILList_link_tab {
+	struct ILList_link_tab *prev;
+	struct ILList_link_tab *next;
+} ILList_link;
+
+/*****************************************************************************//**
+  structure for an intrusive double linked list
+
+ @param	length  the number of links in the list
+ @param	head    the first link in the list
+ @param	tail    the last link in the list
+
+  note:
+        the list never allocates or frees anything, a link can only be on one
+        list at a time
+*******************************************************************************/
+
+typedef struct {
+	size_t length;
+	ILList_link *head;
+	ILList_link *tail;
+} ILList;
+
+/*****************************************************************************//**
+  macro to get the structure a link is embedded in
+
+ @param	link    the link
+ @param	type    the type of the structure the link is embedded in
+ @param	member  the name of the link in the structure
+
+ @return	pointer to the structure
+
+  example:
+        struct conn { int fd; ILList_link link; };
+        struct conn *c = ILList_entry (list.head, struct conn, link);
+*******************************************************************************/
+
+#define ILList_entry(link, type, member) \
+	((type *) ((char *) (link) - offsetof (type, member)))
+
+/*****************************************************************************//**
+  type of function to be passed to the iterate function
+
+ @param	list  the list being parsed
+ @param	link  the current link
+ @param	extra the extra pointer passed to the itterate function
+
+ @return	null to continue the itterate loop
+          non null that stops the itterate loop and is returned by the iterate
+          function
+
+  note:
+        the current link can be deleted from the list
+*******************************************************************************/
+
+typedef void *(*ILList_iterate_func) (
+	ILList *list,
+	ILList_link *link,
+	void *extra);
+
+/*****************************************************************************//**
+  type of a function to pass to the delete functions to free the structure
+  a link is embedded in
+
+ @param	link  the link
+
+ @return	nothing
+*******************************************************************************/
+
+typedef void (*ILList_link_free_func) (
+  ILList_link *link);
+
+/*****************************************************************************//**
+	function to add a link to the head of an intrusive linked list
+
+ @param	list	the linked list
+ @param	link	the link to add
+
+ @return	nothing
+
+*******************************************************************************/
+
+void ILList_prepend (
+	ILList *list,
+	ILList_link *link);
+
+/*****************************************************************************//**
+	function to add a link to the tail of an intrusive linked list
+
+ @param	list	the linked list
+ @param	link	the link to add
+
+ @return	nothing
+
+*******************************************************************************/
+
+void ILList_append (
+	ILList *list,
+	ILList_link *link);
+
+/*****************************************************************************//**
+	function to add a link after any link in an intrusive linked list
+
+ @param	list	the linked list
+ @param	node	the link you wish to place the new link after
+ @param	link	the link to add
+
+ @return	nothing
+
+  note:
+        if node is null the link will be appended to the list
+*******************************************************************************/
+
+void ILList_insert_after (
+	ILList *list,
+	ILList_link *node,
+	ILList_link *link);
+
+/*****************************************************************************//**
+	function to add a link before any link in an intrusive linked list
+
+ @param	list	the linked list
+ @param	node	the link you wish to place the new link before
+ @param	link	the link to add
+
+ @return	nothing
+
+  note:
+        if node is null the link will be prepended to the list
+*******************************************************************************/
+
+void ILList_insert_before (
+	ILList *list,
+	ILList_link *node,
+	ILList_link *link);
+
+/*****************************************************************************//**
+	function to remove a link from an intrusive linked list
+
+ @param	list	the linked list
+ @param	link	the link to remove
+
+ @return	the link
+
+*******************************************************************************/
+
+ILList_link *ILList_delete (
+	ILList *list,
+	ILList_link *link);
+
+/*****************************************************************************//**
+	function to count the links in an intrusive linked list
+
+ @param	list	the linked list
+
+ @return	the number of links in the linked list
+
+*******************************************************************************/
+
+size_t ILList_length (
+	ILList *list);
+
+/*****************************************************************************//**
+	function to iterate an intrusive linked list
+
+ @param	list 		the linked list
+ @param	function	the function to pass each link to for processing
+ @param	extra		extra data to pass to/from the proccessing function
+
+ @return	the non null returned from the proccessing function that stops the
+			iteration
+			NULL if the end of the linked list was reached
+
+*******************************************************************************/
+
+void *ILList_iterate (
+	ILList *list,
+	ILList_iterate_func function,
+	void *extra);
+
+/*****************************************************************************//**
+	function to remove all the links in an intrusive linked list
+
+ @param	list		the linked list
+ @param	function	the function to call to free the structure each link is
+								embedded in, or NULL
+
+ @return	nothing
+
+*******************************************************************************/
+
+void ILList_delete_all (
+	ILList *list,
+	ILList_link_free_func function);
+
+/*****************************************************************************//**
+	function to move another intrusive linked list to the head of an intrusive
+	linked list
+
+ @param	dest	the linked list you want to move the src to
+ @param	src		the linked list you want to move to the dest
+
+ @return	nothing
+
+*******************************************************************************/
+
+void ILList_prepend_list (
+	ILList *dest,
+	ILList *src);
+
+/*****************************************************************************//**
+	function to move another intrusive linked list to the tail of an intrusive
+	linked list
+
+ @param	dest	the linked list you want to move the src to
+ @param	src		the linked list you want to move to the dest
+
+ @return	nothing
+
+*******************************************************************************/
+
+void ILList_append_list (
+	ILList *dest,
+	ILList *src);
+
+/*****************************************************************************//**
+	function to move another intrusive linked list to the middle of an
+	intrusive linked list, after a particular link
+
+ @param	dest	the linked list you want to move the src to
+ @param	src		the linked list you want to move to the dest
+ @param	node	the link you wish to insert src after
+
+ @return	nothing
+
+	if node is null src is appended to dest
+
+*******************************************************************************/
+
+void ILList_insert_list_after (
+	ILList *dest,
+	ILList *src,
+	ILList_link *node);
+
+/*****************************************************************************//**
+	function to move another intrusive linked list to the middle of an
+	intrusive linked list, before a particular link
+
+ @param	dest	the linked list you want to move the src to
+ @param	src		the linked list you want to move to the dest
+ @param	node	the link you wish to insert src before
+
+ @return	nothing
+
+	if node is null src is prepended to dest
+
+*******************************************************************************/
+
+void ILList_insert_list_before (
+	ILList *dest,
+	ILList *src,
+	ILList_link *node);
+
+#endif
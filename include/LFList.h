@@ -0,0 +1,250 @@
+/*******************************************************************************
+	LFList.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef LFList_h
+#define LFList_h
+
+#include <stddef.h>
+
+/*****************************************************************************//**
+  number of nodes a thread lets pile up before it tries to move the epoch on
+*******************************************************************************/
+
+#define LFLIST_RETIRE_SCAN 64
+
+/*****************************************************************************//**
+  structure for a lock free linked list node
+
+ @param	next     the next node, the low bit is set once the node is deleted
+ @param	data     the data the node holds
+ @param	retired  the next node waiting to be freed
+*******************************************************************************/
+
+typedef struct LFList_node_tab {
+	struct LFList_node_tab *volatile next;
+	void *data;
+	struct LFList_node_tab *retired;
+} LFList_node;
+
+/*****************************************************************************//**
+  structure for a thread using a lock free linked list, used to know when a
+  deleted node can no longer be seen by any thread and can be freed
+
+ @param	next     the next thread record of the list
+ @param	used     non zero while a thread holds the record
+ @param	active   non zero while the thread is inside a list function
+ @param	epoch    the list epoch the thread saw when it last came in
+ @param	retired  the deleted nodes waiting to be freed, by epoch mod 3
+ @param	tag      the epoch the nodes in each retired list were deleted in
+ @param	pending  the number of nodes waiting to be freed
+*******************************************************************************/
+
+typedef struct LFList_thread_tab {
+	struct LFList_thread_tab *next;
+	volatile int used;
+	volatile int active;
+	volatile unsigned long epoch;
+	LFList_node *retired[3];
+	unsigned long tag[3];
+	size_t pending;
+} LFList_thread;
+
+/*****************************************************************************//**
+  type of function to pass to compare data
+
+ @param	data1   the first data pointer to be compared
+ @param	data2   the second data pointer to be compared
+
+ @return	less than 0 if data1 is less than data2
+        0 if data1 is equal to data2
+        greater than 0 if data1 is greater than data2
+
+   note
+        if data is a char pointer strcmp() can be passed
+*******************************************************************************/
+
+typedef int (*LFList_data_cmp_func) (
+  void *data1,
+  void *data2);
+
+/*****************************************************************************//**
+  type of a function to pass to the delete functions to free the data
+
+ @param	data  pointer to the data to be free'ed
+
+ @return	nothing
+
+  note:
+        free() can be used if the data is a simple type
+*******************************************************************************/
+
+typedef void (*LFList_data_free_func) (
+  void *data);
+
+/*****************************************************************************//**
+  structure for a lock free sorted linked list set
+
+ @param	length   the number of nodes in the list
+ @param	head     the first node in the list
+ @param	epoch    the global epoch, moved on once every thread inside a list
+                 function has seen it
+ @param	threads  the thread records
+ @param	cmp      function to compare the data in the nodes
+ @param	free     function to free the data in a node once it is safe, or NULL
+
+  note:
+        a zero filled LFList with cmp set is a valid empty list
+        the list is a Harris / Michael list, a node is deleted by marking its
+        next pointer then unlinked with a compare and swap by whichever
+        thread gets there first, deleted nodes are freed with epoch based
+        reclamation
+*******************************************************************************/
+
+typedef struct {
+	volatile size_t length;
+	LFList_node *volatile head;
+	volatile unsigned long epoch;
+	LFList_thread *volatile threads;
+	LFList_data_cmp_func cmp;
+	LFList_data_free_func free;
+} LFList;
+
+/*****************************************************************************//**
+	function to get a thread record for the calling thread
+
+ @param	list	the linked list
+
+ @return	the thread record to pass to the other functions
+				NULL on error
+
+  note:
+        each thread needs its own record, records released with
+        LFList_thread_release () are reused
+*******************************************************************************/
+
+LFList_thread *LFList_thread_get (
+	LFList * list);
+
+/*****************************************************************************//**
+	function to release a thread record
+
+ @param	list	the linked list
+ @param	thread	the thread record
+
+ @return	nothing
+
+  note:
+        nodes the thread deleted that could not be freed yet are freed by the
+        next thread to get the record, or by LFList_delete_all ()
+*******************************************************************************/
+
+void LFList_thread_release (
+	LFList * list,
+	LFList_thread * thread);
+
+/*****************************************************************************//**
+	function to find data in a lock free linked list
+
+ @param	list	the linked list
+ @param	thread	the calling thread's record
+ @param	data	the data to look for
+
+ @return	non zero if data equal to data is in the list
+				0 if not
+
+*******************************************************************************/
+
+int LFList_find (
+	LFList * list,
+	LFList_thread * thread,
+	void *data);
+
+/*****************************************************************************//**
+	function to add data to a lock free linked list
+
+ @param	list	the linked list
+ @param	thread	the calling thread's record
+ @param	data	the data you wish to store in the linked list
+
+ @return	0 on success
+				1 if equal data is already in the list
+				-1 on error
+
+*******************************************************************************/
+
+int LFList_insert (
+	LFList * list,
+	LFList_thread * thread,
+	void *data);
+
+/*****************************************************************************//**
+	function to delete data from a lock free linked list
+
+ @param	list	the linked list
+ @param	thread	the calling thread's record
+ @param	data	the data to delete
+
+ @return	0 on success
+				1 if no equal data is in the list
+
+  note:
+        the data in the list is passed to list->free once no thread can see
+        the node
+*******************************************************************************/
+
+int LFList_delete (
+	LFList * list,
+	LFList_thread * thread,
+	void *data);
+
+/*****************************************************************************//**
+	function to count the nodes in a lock free linked list
+
+ @param	list	the linked list
+
+ @return	the number of nodes in the linked list
+
+  note:
+        with other threads working on the list the count is only a snapshot
+*******************************************************************************/
+
+size_t LFList_length (
+	LFList * list);
+
+/*****************************************************************************//**
+	function to delete all the nodes and thread records of a lock free linked
+	list
+
+ @param	list	the linked list
+
+ @return	nothing
+
+  note:
+        no other thread may be using the list, list->free is called for the
+        data in every node
+*******************************************************************************/
+
+void LFList_delete_all (
+	LFList * list);
+
+#endif
@@ -0,0 +1,168 @@
+/*******************************************************************************
+	LFQueue.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef LFQueue_h
+#define LFQueue_h
+
+#include <stddef.h>
+
+/*****************************************************************************//**
+  structure for a counted pointer in a lock free que, the node and a tag are
+  swapped together so a node that is pulled and reused is not mistaken for
+  the one a thread read
+
+ @param	node  the node pointed to
+ @param	tag   counts the changes to the pointer
+*******************************************************************************/
+
+typedef struct {
+	struct LFQueue_node_tab *volatile node;
+	volatile size_t tag;
+} __attribute__ ((aligned (2 * sizeof (void *)))) LFQueue_ptr;
+
+/*****************************************************************************//**
+  structure for a lock free que node
+
+ @param	next  the next node, toward the head
+ @param	data  the data the node holds
+*******************************************************************************/
+
+typedef struct LFQueue_node_tab {
+	LFQueue_ptr next;
+	void *volatile data;
+} LFQueue_node;
+
+/*****************************************************************************//**
+  structure for a lock free que
+
+ @param	head    the dummy node before the next node to pull
+ @param	tail    the last node pushed, or close to it
+ @param	spare   the top of the stack of unused nodes
+ @param	length  the number of nodes in the que
+ @param	stub    the first dummy node
+
+  note:
+        a zero filled LFQueue is a valid empty que
+        the que is a Michael / Scott que, pulled nodes are kept for reuse and
+        only freed by LFQueue_delete_all (), so a thread that read a node
+        that was pulled under it still reads valid memory
+*******************************************************************************/
+
+typedef struct {
+	LFQueue_ptr head;
+	LFQueue_ptr tail;
+	LFQueue_ptr spare;
+	volatile size_t length;
+	LFQueue_node stub;
+} LFQueue;
+
+/*****************************************************************************//**
+  type of a function to pass to the delete functions to free the data
+
+ @param	data  pointer to the data to be free'ed
+
+ @return	nothing
+
+  note:
+        free() can be used if the data is a simple type
+*******************************************************************************/
+
+typedef void (*LFQueue_data_free_func) (
+  void *data);
+
+/*****************************************************************************//**
+	function to push a node onto a lock free que
+
+ @param	list	the que
+ @param	data	the data you wish to store in the que
+
+ @return	the new node
+				NULL on error
+
+*******************************************************************************/
+
+LFQueue_node *LFQueue_push (
+	LFQueue * list,
+	void *data);
+
+/*****************************************************************************//**
+	function to pull a node from a lock free que
+
+ @param	list	the que
+
+ @return	the data the node held
+				NULL if the que is empty
+
+*******************************************************************************/
+
+void *LFQueue_pull (
+	LFQueue * list);
+
+/*****************************************************************************//**
+	function to read the data that will be pulled next without pulling it
+
+ @param	list	the que
+
+ @return	the data the node holds
+				NULL if the que is empty
+
+  note:
+        with other threads pulling the result is only a snapshot
+*******************************************************************************/
+
+void *LFQueue_read (
+	LFQueue * list);
+
+/*****************************************************************************//**
+	function to count the nodes in a lock free que
+
+ @param	list	the que
+
+ @return	the number of nodes in the que
+
+  note:
+        with other threads working on the que the count is only a snapshot,
+        nodes are counted before they are linked in so it can be a little
+        high but never wraps below 0
+*******************************************************************************/
+
+size_t LFQueue_length (
+	LFQueue * list);
+
+/*****************************************************************************//**
+	function to delete all the nodes in a lock free que
+
+ @param	list		the que
+ @param	function	the function to call to free the data, or NULL
+
+ @return	nothing
+
+  note:
+        no other thread may be using the que, the unused nodes are freed too
+*******************************************************************************/
+
+void LFQueue_delete_all (
+	LFQueue * list,
+	LFQueue_data_free_func function);
+
+#endif
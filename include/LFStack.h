@@ -0,0 +1,199 @@
+/*******************************************************************************
+	LFStack.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef LFStack_h
+#define LFStack_h
+
+#include <stddef.h>
+
+/*****************************************************************************//**
+  structure for a lock free stack node
+
+ @param	next  the next node down the stack
+ @param	data  the data the node holds
+*******************************************************************************/
+
+typedef struct LFStack_node_tab {
+	struct LFStack_node_tab *volatile next;
+	void *volatile data;
+} LFStack_node;
+
+/*****************************************************************************//**
+  structure for the top of a lock free stack, the node and a tag are swapped
+  together so a node that is popped and pushed back is not mistaken for the
+  one a thread read
+
+ @param	node  the top node
+ @param	tag   counts the changes to the top
+*******************************************************************************/
+
+typedef struct {
+	LFStack_node *volatile node;
+	volatile size_t tag;
+} __attribute__ ((aligned (2 * sizeof (void *)))) LFStack_top;
+
+/*****************************************************************************//**
+  structure for a lock free stack
+
+ @param	head    the top of the stack
+ @param	spare   the top of the stack of unused nodes
+ @param	length  the number of nodes in the stack
+
+  note:
+        a zero filled LFStack is a valid empty stack
+        popped nodes are kept for reuse and only freed by LFStack_delete_all (),
+        so a thread that read a node that was popped under it still reads
+        valid memory
+*******************************************************************************/
+
+typedef struct {
+	LFStack_top head;
+	LFStack_top spare;
+	volatile size_t length;
+} LFStack;
+
+/*****************************************************************************//**
+  type of a function to pass to the delete functions to free the data
+
+ @param	data  pointer to the data to be free'ed
+
+ @return	nothing
+
+  note:
+        free() can be used if the data is a simple type
+*******************************************************************************/
+
+typedef void (*LFStack_data_free_func) (
+  void *data);
+
+/*****************************************************************************//**
+	function to push a node onto a lock free stack
+
+ @param	list	the stack
+ @param	data	the data you wish to store in the stack
+
+ @return	the new node
+				NULL on error
+
+*******************************************************************************/
+
+LFStack_node *LFStack_push (
+	LFStack * list,
+	void *data);
+
+/*****************************************************************************//**
+	function to pop a node from a lock free stack
+
+ @param	list	the stack
+
+ @return	the data the node held
+				NULL if the stack is empty
+
+*******************************************************************************/
+
+void *LFStack_pop (
+	LFStack * list);
+
+/*****************************************************************************//**
+	function to read the head of a lock free stack without popping it
+
+ @param	list	the stack
+
+ @return	the data the node holds
+				NULL if the stack is empty
+
+  note:
+        with other threads popping the result is only a snapshot
+*******************************************************************************/
+
+void *LFStack_read_head (
+	LFStack * list);
+
+/*****************************************************************************//**
+	function to count the nodes in a lock free stack
+
+ @param	list	the stack
+
+ @return	the number of nodes in the stack
+
+  note:
+        with other threads working on the stack the count is only a snapshot,
+        nodes are counted before they are linked in so it can be a little
+        high but never wraps below 0
+*******************************************************************************/
+
+size_t LFStack_length (
+	LFStack * list);
+
+/*****************************************************************************//**
+	function to move another lock free stack to the head of a lock free stack
+
+ @param	dest	the stack you want to move the src to
+ @param	src		the stack you want to move to the dest
+
+ @return	nothing
+
+  note:
+        the src is taken with one swap and put on the dest with one swap, its
+        order is kept so its top ends up on top
+*******************************************************************************/
+
+void LFStack_push_list (
+	LFStack * dest,
+	LFStack * src);
+
+/*****************************************************************************//**
+	function to pop every node from a lock free stack at once
+
+ @param	list	the stack
+ @param	dest	the stack to push the nodes onto
+
+ @return	the number of nodes moved
+
+  note:
+        the nodes are taken with one swap, so no push from another thread
+        ends up in the middle of them
+*******************************************************************************/
+
+size_t LFStack_pop_all (
+	LFStack * list,
+	LFStack * dest);
+
+/*****************************************************************************//**
+	function to delete all the nodes in a lock free stack
+
+ @param	list		the stack
+ @param	function	the function to call to free the data, or NULL
+
+ @return	nothing
+
+  note:
+        no other thread may be using the stack, the unused nodes are freed
+        too
+*******************************************************************************/
+
+void LFStack_delete_all (
+	LFStack * list,
+	LFStack_data_free_func function);
+
+#endif
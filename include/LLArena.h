@@ -0,0 +1,141 @@
+/*******************************************************************************
+	LLArena.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef LLArena_h
+#define LLArena_h
+
+#include <stddef.h>
+
+/*****************************************************************************//**
+  default number of bytes in each chunk of an arena
+*******************************************************************************/
+
+#define LLARENA_CHUNKSIZE 65536
+
+/*****************************************************************************//**
+  structure for the header of a chunk of an arena
+
+ @param	next   the chunk before this one
+ @param	size   the number of bytes after the header
+*******************************************************************************/
+
+typedef union LLArena_chunk_tab {
+	struct {
+		union LLArena_chunk_tab *next;
+		size_t size;
+	} head;
+	long double align;
+} LLArena_chunk;
+
+/*****************************************************************************//**
+  structure for an arena, memory is handed out from large chunks in order
+  and only given back all at once or back to a mark
+
+ @param	chunksize  the number of bytes in each chunk, LLARENA_CHUNKSIZE if 0
+ @param	chunk      the newest chunk
+ @param	used       the number of bytes handed out from the newest chunk
+
+  note:
+        a zero filled LLArena is a valid empty arena
+        an allocation bigger than the chunk size gets a chunk of its own
+*******************************************************************************/
+
+typedef struct {
+	size_t chunksize;
+	LLArena_chunk *chunk;
+	size_t used;
+} LLArena;
+
+/*****************************************************************************//**
+  structure for a mark in an arena
+
+ @param	chunk  the newest chunk when the mark was saved
+ @param	used   the bytes used from it
+*******************************************************************************/
+
+typedef struct {
+	LLArena_chunk *chunk;
+	size_t used;
+} LLArena_mark;
+
+/*****************************************************************************//**
+	function to get memory from an arena
+
+ @param	arena	the arena
+ @param	size	the number of bytes
+
+ @return	the memory, aligned for any type
+				NULL on error
+
+*******************************************************************************/
+
+void *LLArena_alloc (
+	LLArena *arena,
+	size_t size);
+
+/*****************************************************************************//**
+	function to save a mark in an arena
+
+ @param	arena	the arena
+ @param	mark	the mark to fill in
+
+ @return	nothing
+
+*******************************************************************************/
+
+void LLArena_save (
+	LLArena *arena,
+	LLArena_mark *mark);
+
+/*****************************************************************************//**
+	function to give back everything an arena handed out since a mark
+
+ @param	arena	the arena
+ @param	mark	a mark saved in the arena
+
+ @return	nothing
+
+  note:
+        the chunks started since the mark are freed, memory handed out
+        before the mark stays valid
+*******************************************************************************/
+
+void LLArena_release (
+	LLArena *arena,
+	LLArena_mark *mark);
+
+/*****************************************************************************//**
+	function to free all the chunks in an arena at once
+
+ @param	arena	the arena
+
+ @return	nothing
+
+  note:
+        every allocation from the arena becomes invalid
+*******************************************************************************/
+
+void LLArena_delete_all (
+	LLArena *arena);
+
+#endif
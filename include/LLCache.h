@@ -0,0 +1,266 @@
+/*******************************************************************************
+	LLCache.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef LLCache_h
+#define LLCache_h
+
+#include <stddef.h>
+#include "LLPool.h"
+#include "ILList.h"
+
+/*****************************************************************************//**
+  number of buckets the hash index of a cache starts with
+*******************************************************************************/
+
+#define LLCACHE_BUCKETS 16
+
+/*****************************************************************************//**
+  eviction policies
+
+  LLCACHE_LRU    evict the least recently used entry, a hit moves the entry to
+                 the head of the list
+  LLCACHE_CLOCK  second chance, a hit only sets the entry's referenced flag and
+                 a hand sweeping the list evicts the first entry without it
+*******************************************************************************/
+
+#define LLCACHE_LRU 0
+#define LLCACHE_CLOCK 1
+
+/*****************************************************************************//**
+  structure for an entry in a cache
+
+ @param	link   the entry's link in the eviction order
+ @param	chain  the next entry in the same hash bucket
+ @param	hash   the hash of the key
+ @param	key    the key
+ @param	data   the data
+ @param	ref    non zero if the entry was hit since the clock hand last passed
+*******************************************************************************/
+
+typedef struct LLCache_entry_tab {
+	ILList_link link;
+	struct LLCache_entry_tab *chain;
+	size_t hash;
+	void *key;
+	void *data;
+	int ref;
+} LLCache_entry;
+
+/*****************************************************************************//**
+  type of function to pass to hash a key
+
+ @param	key  the key
+
+ @return	the hash of the key
+
+  note:
+        LLCache_hash_string () can be passed if the key is a char pointer
+*******************************************************************************/
+
+typedef size_t (*LLCache_key_hash_func) (
+  void *key);
+
+/*****************************************************************************//**
+  type of function to pass to compare keys
+
+ @param	key1   the first key to be compared
+ @param	key2   the second key to be compared
+
+ @return	0 if key1 is equal to key2
+ @return	non zero if they are not equal
+
+   note
+        if the key is a char pointer strcmp() can be passed
+*******************************************************************************/
+
+typedef int (*LLCache_key_cmp_func) (
+  void *key1,
+  void *key2);
+
+/*****************************************************************************//**
+  type of a function to pass to free the data that leaves the cache
+
+ @param	data  pointer to the data to be free'ed
+
+ @return	nothing
+
+  note:
+        free() can be used if the data is a simple type
+*******************************************************************************/
+
+typedef void (*LLCache_data_free_func) (
+  void *data);
+
+/*****************************************************************************//**
+  structure for a bounded cache with a hash index
+
+ @param	capacity   the most entries the cache holds, 0 for no limit
+ @param	policy     LLCACHE_LRU or LLCACHE_CLOCK
+ @param	hash       function to hash the keys
+ @param	cmp        function to compare the keys
+ @param	free       function called with the data of each entry that is
+                   evicted, replaced or deleted with the cache, or NULL
+ @param	hits       the number of gets that found their key
+ @param	misses     the number of gets that did not
+ @param	evictions  the number of entries evicted to make room
+ @param	length     the number of entries in the cache
+ @param	buckets    the number of buckets in the hash index, a power of 2
+ @param	table      the hash index
+ @param	list       the entries, the head is the most recently used for
+                   LLCACHE_LRU
+ @param	hand       the clock hand, the next entry LLCACHE_CLOCK looks at
+ @param	pool       the pool the entries are taken from
+
+  note:
+        a zero filled LLCache with hash, cmp and capacity set is a valid empty
+        cache, free and policy are optional
+        the cache does not copy or free keys, a key is usually a pointer into
+        its data so it goes when the data is freed
+*******************************************************************************/
+
+typedef struct {
+	size_t capacity;
+	int policy;
+	LLCache_key_hash_func hash;
+	LLCache_key_cmp_func cmp;
+	LLCache_data_free_func free;
+	size_t hits;
+	size_t misses;
+	size_t evictions;
+	size_t length;
+	size_t buckets;
+	LLCache_entry **table;
+	ILList list;
+	ILList_link *hand;
+	LLPool pool;
+} LLCache;
+
+/*****************************************************************************//**
+	function to look up a key in a cache, counting it as a use
+
+ @param	cache	the cache
+ @param	key		the key to look for
+
+ @return	the data stored with the key
+				NULL if the key is not in the cache
+
+*******************************************************************************/
+
+void *LLCache_get (
+	LLCache * cache,
+	void *key);
+
+/*****************************************************************************//**
+	function to look up a key in a cache without counting it as a use
+
+ @param	cache	the cache
+ @param	key		the key to look for
+
+ @return	the data stored with the key
+				NULL if the key is not in the cache
+
+  note:
+        the eviction order and the hit and miss counts are not changed
+*******************************************************************************/
+
+void *LLCache_peek (
+	LLCache * cache,
+	void *key);
+
+/*****************************************************************************//**
+	function to store data in a cache
+
+ @param	cache	the cache
+ @param	key		the key to store the data under
+ @param	data	the data
+
+ @return	the data
+				NULL on error
+
+  note:
+        if the key is already in the cache the old data is passed to
+        cache->free and replaced
+        if the cache is full an entry is evicted first and its data passed to
+        cache->free, the entry is reused so a full cache allocates nothing
+*******************************************************************************/
+
+void *LLCache_put (
+	LLCache * cache,
+	void *key,
+	void *data);
+
+/*****************************************************************************//**
+	function to remove a key from a cache
+
+ @param	cache	the cache
+ @param	key		the key to remove
+
+ @return	the data stored with the key, it is not passed to cache->free
+				NULL if the key is not in the cache
+
+*******************************************************************************/
+
+void *LLCache_delete (
+	LLCache * cache,
+	void *key);
+
+/*****************************************************************************//**
+	function to count the entries in a cache
+
+ @param	cache	the cache
+
+ @return	the number of entries in the cache
+
+*******************************************************************************/
+
+size_t LLCache_length (
+	LLCache * cache);
+
+/*****************************************************************************//**
+	function to delete all the entries in a cache
+
+ @param	cache	the cache
+
+ @return	nothing
+
+  note:
+        cache->free is called for the data in each entry if it is set
+        the settings and the counters are kept
+*******************************************************************************/
+
+void LLCache_delete_all (
+	LLCache * cache);
+
+/*****************************************************************************//**
+	function to hash a string key
+
+ @param	key	the string
+
+ @return	the hash of the string
+
+*******************************************************************************/
+
+size_t LLCache_hash_string (
+	void *key);
+
+#endif
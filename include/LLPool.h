@@ -0,0 +1,157 @@
+/*******************************************************************************
+	LLPool.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef LLPool_h
+#define LLPool_h
+
+#include <stddef.h>
+
+/*****************************************************************************//**
+  default number of nodes carved out of each slab
+*******************************************************************************/
+
+#define LLPOOL_SLABSIZE 1024
+
+/*****************************************************************************//**
+  structure for a free node in a node pool
+
+ @param	next  the next free node
+*******************************************************************************/
+
+typedef struct LLPool_cell_tab {
+	struct LLPool_cell_tab *next;
+} LLPool_cell;
+
+/*****************************************************************************//**
+  structure for the header of a slab of nodes
+
+ @param	next  the next slab in the pool
+*******************************************************************************/
+
+typedef union LLPool_slab_tab {
+	union LLPool_slab_tab *next;
+	long double align;
+} LLPool_slab;
+
+/*****************************************************************************//**
+  structure for a node pool
+
+ @param	nodesize  the size of each node, set on the first allocation if 0
+ @param	slabsize  the number of nodes in each slab, LLPOOL_SLABSIZE if 0
+ @param	used      the number of nodes handed out and not yet returned
+ @param	slabs     the number of slabs the pool holds
+ @param	slab      the most recently allocated slab
+ @param	free      the list of returned nodes
+ @param	next      the next never used node in the newest slab
+ @param	end       the end of the newest slab
+
+  note:
+        a zero filled LLPool is a valid empty pool
+        a pool can be shared by any lists with the same node size,
+        SLList and stackLList nodes are one size, DLList, CLList, QLList and
+        DQLList nodes are another
+        lists that move nodes between each other with the *_list functions must
+        share the same pool, or all use no pool
+*******************************************************************************/
+
+typedef struct {
+	size_t nodesize;
+	size_t slabsize;
+	size_t used;
+	size_t slabs;
+	LLPool_slab *slab;
+	LLPool_cell *free;
+	char *next;
+	char *end;
+} LLPool;
+
+/*****************************************************************************//**
+	function to get a node from a node pool
+
+ @param	pool	the pool, or NULL to use malloc
+ @param	size	the size of the node
+
+ @return	the new node
+				NULL on error
+
+  note:
+        size must not be larger than the size the pool was first used with
+*******************************************************************************/
+
+void *LLPool_alloc (
+	LLPool *pool,
+	size_t size);
+
+/*****************************************************************************//**
+	function to get a run of nodes from a node pool in one block
+
+ @param	pool	the pool
+ @param	size	the size of each node
+ @param	count	the number of nodes
+
+ @return	the first node, the rest follow every pool->nodesize bytes
+				NULL on error
+
+  note:
+        the nodes are returned to the pool one at a time with LLPool_free ()
+        like any other, what is left of the newest slab is put on the free list
+        if the run does not fit in it
+*******************************************************************************/
+
+void *LLPool_alloc_block (
+	LLPool *pool,
+	size_t size,
+	size_t count);
+
+/*****************************************************************************//**
+	function to return a node to a node pool
+
+ @param	pool	the pool, or NULL to use free
+ @param	node	the node to return
+
+ @return	nothing
+
+*******************************************************************************/
+
+void LLPool_free (
+	LLPool *pool,
+	void *node);
+
+/*****************************************************************************//**
+	function to release all the slabs in a node pool at once
+
+ @param	pool	the pool
+
+ @return	nothing
+
+  note:
+        every node handed out by the pool becomes invalid, only call this
+        when no list holds nodes from the pool
+        the *_delete_all functions call this for you when they return the last
+        node in use
+*******************************************************************************/
+
+void LLPool_delete_all (
+	LLPool *pool);
+
+#endif
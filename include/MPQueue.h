@@ -0,0 +1,229 @@
+/*******************************************************************************
+	MPQueue.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef MPQueue_h
+#define MPQueue_h
+
+#include <stddef.h>
+
+/*****************************************************************************//**
+  default number of slots in a multi producer que
+*******************************************************************************/
+
+#define MPQUEUE_SIZE 1024
+
+/*****************************************************************************//**
+  size of a cache line, the push and pull positions are kept this far apart
+  so producers and consumers do not fight over one line
+*******************************************************************************/
+
+#define MPQUEUE_CACHELINE 64
+
+/*****************************************************************************//**
+  structure for a slot in a multi producer que
+
+ @param	seq   the position the slot is ready for, equal to the position when
+              it is free to push into, one past it when it holds data to pull
+ @param	data  the data the slot holds
+*******************************************************************************/
+
+typedef struct {
+	volatile size_t seq;
+	void *volatile data;
+} MPQueue_cell;
+
+/*****************************************************************************//**
+  structure for a multi producer multi consumer que, a ring buffer of slots
+  that each carry a sequence number
+
+ @param	size    the number of slots, rounded up to a power of 2 when the
+                buffer is allocated, MPQUEUE_SIZE if 0
+ @param	buffer  the slots, allocated on the first push
+ @param	mask    size - 1, to wrap the positions
+ @param	state   0 before the buffer is allocated, 1 while a thread allocates
+                it, 2 once it is ready
+ @param	head    the next position to push into
+ @param	tail    the next position to pull from
+
+  note:
+        a zero filled MPQueue is a valid empty que
+        any number of threads may push and pull at once without locks
+        NULL can not be pushed, it is what the pull functions return when the
+        que is empty
+*******************************************************************************/
+
+typedef struct {
+	size_t size;
+	MPQueue_cell *buffer;
+	size_t mask;
+	volatile int state;
+	volatile size_t head __attribute__ ((aligned (MPQUEUE_CACHELINE)));
+	volatile size_t tail __attribute__ ((aligned (MPQUEUE_CACHELINE)));
+} MPQueue;
+
+/*****************************************************************************//**
+  type of a function to pass to the delete functions to free the data
+
+ @param	data  pointer to the data to be free'ed
+
+ @return	nothing
+
+  note:
+        free() can be used if the data is a simple type
+*******************************************************************************/
+
+typedef void (*MPQueue_data_free_func) (
+  void *data);
+
+/*****************************************************************************//**
+	function to push data onto a multi producer que if there is room
+
+ @param	list	the que
+ @param	data	the data you wish to store in the que
+
+ @return	0 on success
+				1 if the que is full
+				-1 on error
+
+*******************************************************************************/
+
+int MPQueue_try_push (
+	MPQueue * list,
+	void *data);
+
+/*****************************************************************************//**
+	function to push data onto a multi producer que, waiting for room
+
+ @param	list	the que
+ @param	data	the data you wish to store in the que
+
+ @return	0 on success
+				-1 on error
+
+  note:
+        the thread yields the cpu while it waits
+*******************************************************************************/
+
+int MPQueue_push (
+	MPQueue * list,
+	void *data);
+
+/*****************************************************************************//**
+	function to pull data from a multi producer que if there is any
+
+ @param	list	the que
+
+ @return	the data
+				NULL if the que is empty
+
+*******************************************************************************/
+
+void *MPQueue_try_pull (
+	MPQueue * list);
+
+/*****************************************************************************//**
+	function to pull data from a multi producer que, waiting for some
+
+ @param	list	the que
+
+ @return	the data
+
+  note:
+        the thread yields the cpu while it waits
+*******************************************************************************/
+
+void *MPQueue_pull (
+	MPQueue * list);
+
+/*****************************************************************************//**
+	function to push the data in an array onto a multi producer que
+
+ @param	list	the que
+ @param	array	the data you wish to store in the que
+ @param	count	the number of entries in the array
+
+ @return	the number of entries pushed, less than count if the que filled up
+				or on error
+
+  note:
+        each run of free slots is claimed with one compare and swap, so the
+        entries of a run come out together unless other consumers interleave
+*******************************************************************************/
+
+size_t MPQueue_push_n (
+	MPQueue * list,
+	void **array,
+	size_t count);
+
+/*****************************************************************************//**
+	function to pull data from a multi producer que into an array
+
+ @param	list	the que
+ @param	array	the array to fill
+ @param	count	the number of entries in the array
+
+ @return	the number of entries filled in, less than count if the que ran
+				out
+
+  note:
+        each run of full slots is claimed with one compare and swap
+*******************************************************************************/
+
+size_t MPQueue_pull_n (
+	MPQueue * list,
+	void **array,
+	size_t count);
+
+/*****************************************************************************//**
+	function to count the items in a multi producer que
+
+ @param	list	the que
+
+ @return	the number of items in the que
+
+  note:
+        with other threads working on the que the count is only a snapshot,
+        it counts slots claimed by a push that has not finished yet
+*******************************************************************************/
+
+size_t MPQueue_length (
+	MPQueue * list);
+
+/*****************************************************************************//**
+	function to delete all the items in a multi producer que and free its
+	buffer
+
+ @param	list		the que
+ @param	function	the function to call to free the data, or NULL
+
+ @return	nothing
+
+  note:
+        no other thread may be using the que, the size is kept
+*******************************************************************************/
+
+void MPQueue_delete_all (
+	MPQueue * list,
+	MPQueue_data_free_func function);
+
+#endif
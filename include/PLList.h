@@ -0,0 +1,324 @@
+/*******************************************************************************
+	PLList.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef PLList_h
+#define PLList_h
+
+#include <stddef.h>
+
+/*****************************************************************************//**
+  the most levels a positional linked list can have
+*******************************************************************************/
+
+#define PLLIST_MAXLEVEL 32
+
+/*****************************************************************************//**
+  structure for a link on one level of a positional linked list
+
+ @param	next   the next node on the level
+ @param	width  how many positions the link spans, counting the end of the list
+               as the position after the tail
+*******************************************************************************/
+
+typedef struct {
+	struct PLList_node_tab *next;
+	size_t width;
+} PLList_link;
+
+/*****************************************************************************//**
+  structure for a positional linked list node
+
+ @param	prev   the previous node
+ @param	data   the data the node holds
+ @param	level  the number of levels the node is linked into
+ @param	link   the links on each level, link[0].next is the next node
+
+  note:
+        the node is allocated with room for level links
+*******************************************************************************/
+
+typedef struct PLList_node_tab {
+	struct PLList_node_tab *prev;
+	void *data;
+	size_t level;
+	PLList_link link[1];
+} PLList_node;
+
+/*****************************************************************************//**
+  structure for a positional linked list, a double linked list with an
+  indexable skip list over it so nodes can be found by position
+
+ @param	length  the number of nodes in the list
+ @param	level   the number of levels in use
+ @param	seed    the state of the random level generator
+ @param	tail    the last node in the list
+ @param	head    the links from the head on each level, head[0].next is the
+                first node
+
+  note:
+        a zero filled PLList is a valid empty list
+*******************************************************************************/
+
+typedef struct {
+	size_t length;
+	size_t level;
+	unsigned long seed;
+	PLList_node *tail;
+	PLList_link head[PLLIST_MAXLEVEL];
+} PLList;
+
+/*****************************************************************************//**
+  macro to get the next node in a positional linked list
+
+ @param	node  the node
+
+ @return	the next node
+          NULL if node is the tail
+*******************************************************************************/
+
+#define PLList_next(node) ((node)->link[0].next)
+
+/*****************************************************************************//**
+  type of function to be passed to the iterate function
+
+ @param	list  the list being parsed
+ @param	node  the current node
+ @param	data  the data the current node holds
+ @param	extra the extra pointer passed to the itterate function
+
+ @return	null to continue the itterate loop
+          non null that stops the itterate loop and is returned by the iterate
+          function
+*******************************************************************************/
+
+typedef void *(*PLList_iterate_func) (
+	PLList *list,
+	PLList_node *node,
+	void *data,
+	void *extra);
+
+/*****************************************************************************//**
+  type of a function to pass to the delete functions to free the data
+
+ @param	data  pointer to the data to be free'ed
+
+ @return	nothing
+
+  note:
+        free() can be used if the data is a simple type
+*******************************************************************************/
+
+typedef void (*PLList_data_free_func) (
+  void *data);
+
+/*****************************************************************************//**
+	function to get the node at a position in a positional linked list
+
+ @param	list	the linked list
+ @param	index	the position, 0 is the head
+
+ @return	the node
+				NULL if index is past the tail
+
+*******************************************************************************/
+
+PLList_node *PLList_get (
+	PLList * list,
+	size_t index);
+
+/*****************************************************************************//**
+	function to get the position of a node in a positional linked list
+
+ @param	list	the linked list
+ @param	node	the node
+
+ @return	the position of the node, 0 is the head
+
+*******************************************************************************/
+
+size_t PLList_index (
+	PLList * list,
+	PLList_node * node);
+
+/*****************************************************************************//**
+	function to add a node at a position in a positional linked list
+
+ @param	list	the linked list
+ @param	index	the position the new node will have, 0 prepends, the length
+				appends
+ @param	data	the data you wish to store in the linked list
+
+ @return	the new node
+				NULL on error or if index is past the length
+
+*******************************************************************************/
+
+PLList_node *PLList_insert (
+	PLList * list,
+	size_t index,
+	void *data);
+
+/*****************************************************************************//**
+	function to add a node to the head of a positional linked list
+
+ @param	list	the linked list
+ @param	data	the data you wish to store in the linked list
+
+ @return	the new node
+				NULL on error
+
+*******************************************************************************/
+
+PLList_node *PLList_prepend (
+	PLList * list,
+	void *data);
+
+/*****************************************************************************//**
+	function to add a node to the tail of a positional linked list
+
+ @param	list	the linked list
+ @param	data	the data you wish to store in the linked list
+
+ @return	the new node
+				NULL on error
+
+*******************************************************************************/
+
+PLList_node *PLList_append (
+	PLList * list,
+	void *data);
+
+/*****************************************************************************//**
+	function to add a node after any node in a positional linked list
+
+ @param	list	the linked list
+ @param	node	the node you wish to place the new node after
+ @param	data	the data you wish to store in the linked list
+
+ @return	the new node
+				NULL on error
+
+  note:
+        if node is null the new node will be appended to the list
+*******************************************************************************/
+
+PLList_node *PLList_insert_after (
+	PLList * list,
+	PLList_node * node,
+	void *data);
+
+/*****************************************************************************//**
+	function to add a node before any node in a positional linked list
+
+ @param	list	the linked list
+ @param	node	the node you wish to place the new node before
+ @param	data	the data you wish to store in the linked list
+
+ @return	the new node
+				NULL on error
+
+  note:
+        if node is null the new node will be prepended to the list
+*******************************************************************************/
+
+PLList_node *PLList_insert_before (
+	PLList * list,
+	PLList_node * node,
+	void *data);
+
+/*****************************************************************************//**
+	function to delete the node at a position in a positional linked list
+
+ @param	list	the linked list
+ @param	index	the position of the node, 0 is the head
+
+ @return	the data the node held
+				NULL if index is past the tail
+
+*******************************************************************************/
+
+void *PLList_delete_index (
+	PLList * list,
+	size_t index);
+
+/*****************************************************************************//**
+	function to delete a node from a positional linked list
+
+ @param	list	the linked list
+ @param	node	the node to delete
+
+ @return	the data the node held
+
+*******************************************************************************/
+
+void *PLList_delete (
+	PLList * list,
+	PLList_node * node);
+
+/*****************************************************************************//**
+	function to count the nodes in a positional linked list
+
+ @param	list	the linked list
+
+ @return	the number of nodes in the linked list
+
+*******************************************************************************/
+
+size_t PLList_length (
+	PLList * list);
+
+/*****************************************************************************//**
+	function to iterate a positional linked list
+
+ @param	list 		the linked list
+ @param	function	the function to pass each node to for processing
+ @param	extra		extra data to pass to/from the proccessing function
+
+ @return	the non null returned from the proccessing function that stops the
+				iteration
+				NULL if the end of the linked list was reached
+
+  note:
+        the current node can be deleted from the list
+*******************************************************************************/
+
+void *PLList_iterate (
+	PLList * list,
+	PLList_iterate_func function,
+	void *extra);
+
+/*****************************************************************************//**
+	function to delete all the nodes in a positional linked list
+
+ @param	list		the linked list
+ @param	function	the function to call to free the data, or NULL
+
+ @return	nothing
+
+*******************************************************************************/
+
+void PLList_delete_all (
+	PLList * list,
+	PLList_data_free_func function);
+
+#endif
@@ -26,6 +26,9 @@
 #ifndef QLList_h
 #define QLList_h
 
+#include "LLPool.h"
+#include "LLArena.h"
+
 typedef struct QLList_node_tab {
 	struct QLList_node_tab *prev;
 	struct QLList_node_tab *next;
@@ -36,6 +39,7 @@ typedef struct {
 	size_t length;
 	QLList_node *head;
 	QLList_node *tail;
+	LLPool *pool;
 } QLList;
 
 /*****************************************************************************//**
@@ -91,6 +95,28 @@ typedef void *(*QLList_data_copy_func) (
   void *src);
 
 
+/*****************************************************************************//**
+  type of function to pass to the arena copy functions
+
+ @param	dest   pointer to the new data pointer
+ @param	src    the data pointer in the node to be copyed
+ @param	arena  the arena passed to the copy function, or NULL, the copy can be
+               allocated from it
+
+ @return	the new copyed data
+        NULL on error
+
+  note:
+        with an arena the copies do not need a free function, a failed copy
+        gives the arena back to where it was
+*******************************************************************************/
+
+typedef void *(*QLList_data_arena_copy_func) (
+  void **dest,
+  void *src,
+  LLArena *arena);
+
+
 
 /*****************************************************************************//**
 	function to push a node onto a que
@@ -210,4 +236,78 @@ QLList_node *QLList_push_list_copy (
 	QLList * src,
 	QLList_data_copy_func func);
 
+/*****************************************************************************//**
+	function to push the data in an array onto a que
+
+ @param	list	the linked list
+ @param	array	the data you wish to store in the linked list
+ @param	count	the number of entries in the array
+
+ @return	0 on success
+				1 on error, nothing is pushed
+
+	notes:
+				the same as pushing each entry in turn, array[0] is pulled first
+				with a pool all the nodes are taken from one block
+
+*******************************************************************************/
+
+int QLList_push_array (
+	QLList * list,
+	void **array,
+	size_t count);
+
+/*****************************************************************************//**
+	function to copy the data in a que to an array
+
+ @param	list	the linked list
+ @param	array	the array to fill, it must have room for the length of the list
+
+ @return	the number of entries filled in
+
+	notes:
+				the array is filled from the tail to the head, the order the data
+				would be pulled in
+
+*******************************************************************************/
+
+size_t QLList_to_array (
+	QLList * list,
+	void **array);
+
+
+/*****************************************************************************//**
+	function to copy another list to the head of a que, all or nothing
+
+ @param	dest		the linked list you want to copy the src to
+ @param	src			the linked list you want to copy to the dest
+ @param	copy_func	function to copy the data held in each node
+ @param	free_func	function to free the copies made if a later one fails,
+						or NULL
+ @param	arena		the arena to pass to copy_func, or NULL
+
+ @return	0 on success
+				1 on error, nothing is added
+
+	notes:
+				every copy is made before any node is added, then the nodes are
+				added at once like QLList_push_array ()
+				the nodes are only one block when dest->pool is set, without
+				a pool each node is malloced on its own as it is freed on its
+				own, the copy is still all or nothing
+				on failure the copies are passed to free_func and the arena is
+				released back to where it was
+				you can cast a DLList, CLList, or DQLList to QLList for the src
+				argument
+				the src keeps its order, its head becomes the head of dest
+
+*******************************************************************************/
+
+int QLList_push_list_copy_arena (
+	QLList * dest,
+	QLList * src,
+	QLList_data_arena_copy_func copy_func,
+	QLList_data_free_func free_func,
+	LLArena * arena);
+
 #endif
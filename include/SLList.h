@@ -24,6 +24,9 @@
 #ifndef SLList_h
 #define SLList_h
 
+#include "LLPool.h"
+#include "LLArena.h"
+
 /*****************************************************************************//**
   structure for a single linked list node
   
@@ -42,12 +45,14 @@ typedef struct SLList_tab {
  @param	length  the number of nodes in the list
  @param	head    the first node in the list
  @param	tail    the last node in the list
+ @param	pool    the pool to take nodes from, NULL to use malloc
 *******************************************************************************/
 
 typedef struct {
 	size_t length;
 	SLList_node *head;
 	SLList_node *tail;
+	LLPool *pool;
 } SLList;
 
 /*****************************************************************************//**
@@ -99,6 +104,28 @@ typedef void (*SLList_data_free_func) (void *data);
   
 typedef void *(*SLList_data_copy_func) (void **dest, void *src);
 
+
+/*****************************************************************************//**
+  type of function to pass to the arena copy functions
+
+ @param	dest   pointer to the new data pointer
+ @param	src    the data pointer in the node to be copyed
+ @param	arena  the arena passed to the copy function, or NULL, the copy can be
+               allocated from it
+
+ @return	the new copyed data
+        NULL on error
+
+  note:
+        with an arena the copies do not need a free function, a failed copy
+        gives the arena back to where it was
+*******************************************************************************/
+
+typedef void *(*SLList_data_arena_copy_func) (
+  void **dest,
+  void *src,
+  LLArena *arena);
+
 /*****************************************************************************//**
   type of function to pass to the mergesort to compare the data
   
@@ -115,6 +142,35 @@ typedef void *(*SLList_data_copy_func) (void **dest, void *src);
 
 typedef int (*SLList_data_cmp_func) (void *data1, void *data2);
 
+/*****************************************************************************//**
+  type of function to pass to the radix sort to get the integer key of the data
+
+ @param	data    the data pointer
+
+ @return	the key, the list is sorted by it in ascending order
+*******************************************************************************/
+
+typedef unsigned long long (*SLList_data_key_func) (
+  void *data);
+
+/*****************************************************************************//**
+  type of function to pass to the compact function to learn where each node
+  moved to
+
+ @param	list  the list being compacted
+ @param	old   the node as it was, still readable
+ @param	new   the node that replaces it
+ @param	extra the extra pointer passed to the compact function
+
+ @return	nothing
+*******************************************************************************/
+
+typedef void (*SLList_node_move_func) (
+  SLList *list,
+  SLList_node *old,
+  SLList_node *new,
+  void *extra);
+
 /*****************************************************************************//**
 	function to add a node to the head of a single linked list
 	
@@ -267,6 +323,10 @@ void *SLList_iterate (
 
  @return	nothing
 
+  note:
+        if the list has a pool and this returns the last node the pool handed
+        out, the pool's slabs are released
+
 *******************************************************************************/
 
 void SLList_delete_all (
@@ -448,4 +508,222 @@ void SLList_sort (
 	SLList * list,
 	SLList_data_cmp_func cmp_func);
 
+/*****************************************************************************//**
+	function to sort a single linked list, taking advantage of runs already in
+	the list
+
+ @param	list		the linked list to sort
+ @param	cmp_func	function to compare the data in 2 nodes
+
+ @return	nothing
+
+	Notes:
+				ascending and strictly descending runs are merged TimSort style with
+				galloping, a sorted or reversed list costs length - 1 compares
+				the sort is stable
+
+*******************************************************************************/
+
+void SLList_sort_adaptive (
+	SLList * list,
+	SLList_data_cmp_func cmp_func);
+
+/*****************************************************************************//**
+	function to sort a single linked list in an array
+
+ @param	list		the linked list to sort
+ @param	cmp_func	function to compare the data in 2 nodes
+ @param	relocate	non zero to move the data between the nodes instead of
+									moving the nodes
+
+ @return	0 on success
+				1 if out of memory, the list is left as it was
+
+	Notes:
+				the nodes are gathered into an array, introsorted and relinked in
+				one pass, the sort is not stable
+				with relocate the nodes are relinked in address order and the data
+				is moved into them sorted, walking the list then walks memory
+				forward, best with a pool, but node pointers held elsewhere no
+				longer hold the same data
+
+*******************************************************************************/
+
+int SLList_sort_array (
+	SLList * list,
+	SLList_data_cmp_func cmp_func,
+	int relocate);
+
+/*****************************************************************************//**
+	function to sort a single linked list by an integer key with a radix sort
+
+ @param	list		the linked list to sort
+ @param	key_func	function to get the key of the data in a node
+
+ @return	nothing
+
+	Notes:
+				an LSD radix sort one byte of the key at a time, linear time and
+				stable, bytes that are the same in every key cost no pass
+				nothing is allocated
+
+*******************************************************************************/
+
+void SLList_sort_radix (
+	SLList * list,
+	SLList_data_key_func key_func);
+
+/*****************************************************************************//**
+	function to add the data in an array to the tail of a single linked list
+
+ @param	list	the linked list
+ @param	array	the data you wish to store in the linked list
+ @param	count	the number of entries in the array
+
+ @return	0 on success
+				1 on error, nothing is added
+
+	notes:
+				array[0] ends up nearest the head, as if each was appended in turn
+				with a pool all the nodes are taken from one block
+
+*******************************************************************************/
+
+int SLList_append_array (
+	SLList * list,
+	void **array,
+	size_t count);
+
+/*****************************************************************************//**
+	function to add the data in an array to the head of a single linked list
+
+ @param	list	the linked list
+ @param	array	the data you wish to store in the linked list
+ @param	count	the number of entries in the array
+
+ @return	0 on success
+				1 on error, nothing is added
+
+	notes:
+				array[count - 1] ends up at the head, as if each was prepended in
+				turn
+				with a pool all the nodes are taken from one block
+
+*******************************************************************************/
+
+int SLList_prepend_array (
+	SLList * list,
+	void **array,
+	size_t count);
+
+/*****************************************************************************//**
+	function to copy the data in a single linked list to an array
+
+ @param	list	the linked list
+ @param	array	the array to fill, it must have room for the length of the list
+
+ @return	the number of entries filled in
+
+	notes:
+				the array is filled from the head to the tail
+
+*******************************************************************************/
+
+size_t SLList_to_array (
+	SLList * list,
+	void **array);
+
+/*****************************************************************************//**
+	function to move the nodes of a single linked list next to each other in
+	the order they are linked
+
+ @param	list		the linked list
+ @param	function	function to call for each node moved, or NULL
+ @param	extra		extra data to pass to the function
+
+ @return	0 on success
+				1 on error, the list is left as it was
+
+	Notes:
+				every node is replaced by a new one holding the same data and the
+				old node is freed, node pointers held elsewhere must be updated
+				through function, which is called before each old node is freed
+				with a pool the new nodes are one block, without one they are
+				malloced in order and how close they land is up to malloc
+
+*******************************************************************************/
+
+int SLList_compact (
+	SLList * list,
+	SLList_node_move_func function,
+	void *extra);
+
+
+/*****************************************************************************//**
+	function to copy another list to the tail of a single linked list, all or
+	nothing
+
+ @param	dest		the linked list you want to copy the src to
+ @param	src			the linked list you want to copy to the dest
+ @param	copy_func	function to copy the data held in each node
+ @param	free_func	function to free the copies made if a later one fails,
+						or NULL
+ @param	arena		the arena to pass to copy_func, or NULL
+
+ @return	0 on success
+				1 on error, nothing is added
+
+	notes:
+				every copy is made before any node is added, then the nodes are
+				added at once like SLList_append_array ()
+				the nodes are only one block when dest->pool is set, without
+				a pool each node is malloced on its own as it is freed on its
+				own, the copy is still all or nothing
+				on failure the copies are passed to free_func and the arena is
+				released back to where it was
+				you can cast a stackLList to SLList for the src argument
+
+*******************************************************************************/
+
+int SLList_append_list_copy_arena (
+	SLList * dest,
+	SLList * src,
+	SLList_data_arena_copy_func copy_func,
+	SLList_data_free_func free_func,
+	LLArena * arena);
+
+/*****************************************************************************//**
+	function to copy another list to the head of a single linked list, all or
+	nothing
+
+ @param	dest		the linked list you want to copy the src to
+ @param	src			the linked list you want to copy to the dest
+ @param	copy_func	function to copy the data held in each node
+ @param	free_func	function to free the copies made if a later one fails,
+						or NULL
+ @param	arena		the arena to pass to copy_func, or NULL
+
+ @return	0 on success
+				1 on error, nothing is added
+
+	notes:
+				every copy is made before any node is added, then the nodes are
+				added at once like SLList_prepend_array ()
+				the nodes are only one block when dest->pool is set, without
+				a pool each node is malloced on its own as it is freed on its
+				own, the copy is still all or nothing
+				on failure the copies are passed to free_func and the arena is
+				released back to where it was
+				you can cast a stackLList to SLList for the src argument
+				the src keeps its order, its head becomes the head of dest
+
+*******************************************************************************/
+
+int SLList_prepend_list_copy_arena (
+	SLList * dest,
+	SLList * src,
+	SLList_data_arena_copy_func copy_func,
+	SLList_data_free_func free_func,
+	LLArena * arena);
+
 #endif
@@ -0,0 +1,197 @@
+/*******************************************************************************
+	SPQueue.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef SPQueue_h
+#define SPQueue_h
+
+#include <stddef.h>
+
+/*****************************************************************************//**
+  default number of slots in a single producer que
+*******************************************************************************/
+
+#define SPQUEUE_SIZE 1024
+
+/*****************************************************************************//**
+  size of a cache line, the producer and consumer indexes are kept this far
+  apart so the two threads do not fight over one line
+*******************************************************************************/
+
+#define SPQUEUE_CACHELINE 64
+
+/*****************************************************************************//**
+  structure for a single producer single consumer que, a ring buffer of data
+  pointers
+
+ @param	size       the number of slots, rounded up to a power of 2 when the
+                   buffer is allocated, SPQUEUE_SIZE if 0
+ @param	buffer     the slots, allocated on the first push
+ @param	mask       size - 1, to wrap the indexes
+ @param	head       the number of items ever pushed, only the producer writes it
+ @param	tail_seen  the last tail the producer read
+ @param	tail       the number of items ever pulled, only the consumer writes it
+ @param	head_seen  the last head the consumer read
+
+  note:
+        a zero filled SPQueue is a valid empty que
+        one thread may push and one other thread may pull at the same time
+        without locks, neither ever waits on the other
+        NULL can not be pushed, it is what pull returns when the que is empty
+*******************************************************************************/
+
+typedef struct {
+	size_t size;
+	void **buffer;
+	size_t mask;
+	volatile size_t head __attribute__ ((aligned (SPQUEUE_CACHELINE)));
+	size_t tail_seen;
+	volatile size_t tail __attribute__ ((aligned (SPQUEUE_CACHELINE)));
+	size_t head_seen;
+} SPQueue;
+
+/*****************************************************************************//**
+  type of a function to pass to the delete functions to free the data
+
+ @param	data  pointer to the data to be free'ed
+
+ @return	nothing
+
+  note:
+        free() can be used if the data is a simple type
+*******************************************************************************/
+
+typedef void (*SPQueue_data_free_func) (
+  void *data);
+
+/*****************************************************************************//**
+	function to push data onto a single producer que
+
+ @param	list	the que
+ @param	data	the data you wish to store in the que
+
+ @return	0 on success
+				1 if the que is full
+				-1 on error
+
+*******************************************************************************/
+
+int SPQueue_push (
+	SPQueue * list,
+	void *data);
+
+/*****************************************************************************//**
+	function to pull data from a single producer que
+
+ @param	list	the que
+
+ @return	the data
+				NULL if the que is empty
+
+*******************************************************************************/
+
+void *SPQueue_pull (
+	SPQueue * list);
+
+/*****************************************************************************//**
+	function to push the data in an array onto a single producer que
+
+ @param	list	the que
+ @param	array	the data you wish to store in the que
+ @param	count	the number of entries in the array
+
+ @return	the number of entries pushed, less than count if the que filled up
+				or on error
+
+  note:
+        the consumer sees the whole batch at once
+*******************************************************************************/
+
+size_t SPQueue_push_n (
+	SPQueue * list,
+	void **array,
+	size_t count);
+
+/*****************************************************************************//**
+	function to pull data from a single producer que into an array
+
+ @param	list	the que
+ @param	array	the array to fill
+ @param	count	the number of entries in the array
+
+ @return	the number of entries filled in, less than count if the que ran
+				out
+
+*******************************************************************************/
+
+size_t SPQueue_pull_n (
+	SPQueue * list,
+	void **array,
+	size_t count);
+
+/*****************************************************************************//**
+	function to read the data that will be pulled next without pulling it
+
+ @param	list	the que
+
+ @return	the data
+				NULL if the que is empty
+
+  note:
+        only the consumer may call this
+*******************************************************************************/
+
+void *SPQueue_read (
+	SPQueue * list);
+
+/*****************************************************************************//**
+	function to count the items in a single producer que
+
+ @param	list	the que
+
+ @return	the number of items in the que
+
+  note:
+        with the other thread working on the que the count is only a snapshot
+*******************************************************************************/
+
+size_t SPQueue_length (
+	SPQueue * list);
+
+/*****************************************************************************//**
+	function to delete all the items in a single producer que and free its
+	buffer
+
+ @param	list		the que
+ @param	function	the function to call to free the data, or NULL
+
+ @return	nothing
+
+  note:
+        no other thread may be using the que, the size is kept
+*******************************************************************************/
+
+void SPQueue_delete_all (
+	SPQueue * list,
+	SPQueue_data_free_func function);
+
+#endif
@@ -0,0 +1,295 @@
+/*******************************************************************************
+	SkipList.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef SkipList_h
+#define SkipList_h
+
+#include <stddef.h>
+
+/*****************************************************************************//**
+  the most levels a skip list can have
+*******************************************************************************/
+
+#define SKIPLIST_MAXLEVEL 32
+
+/*****************************************************************************//**
+  structure for a skip list node
+
+ @param	data   the data the node holds
+ @param	level  the number of levels the node is linked into
+ @param	next   the next node on each level, next[0] is the next node in order
+
+  note:
+        the node is allocated with room for level next pointers
+*******************************************************************************/
+
+typedef struct SkipList_node_tab {
+	void *data;
+	size_t level;
+	struct SkipList_node_tab *next[1];
+} SkipList_node;
+
+/*****************************************************************************//**
+  type of function to pass to compare data
+
+ @param	data1   the first data pointer to be compared
+ @param	data2   the second data pointer to be compared
+
+ @return	less than 0 if data1 is less than data2
+ @return	0 if data1 is equal to data2
+ @return	greater than 0 if data1 is greater than data2
+
+   note
+        if data is a char pointer strcmp() can be passed
+*******************************************************************************/
+
+typedef int (*SkipList_data_cmp_func) (
+  void *data1,
+  void *data2);
+
+/*****************************************************************************//**
+  type of a function to pass to the delete functions to free the data
+
+ @param	data  pointer to the data to be free'ed
+
+ @return	nothing
+
+  note:
+        free() can be used if the data is a simple type
+*******************************************************************************/
+
+typedef void (*SkipList_data_free_func) (
+  void *data);
+
+/*****************************************************************************//**
+  type of function to pass to the copy functions
+
+ @param	dest  pointer to the new data pointer
+ @param	src   the data pointer in the node to be copyed
+
+ @return	the new new copyed data
+        NULL on error
+
+  note:
+        that unfortunatly strcpy() CAN NOT be used here. you need to allocate
+        memory and then use strcpy()
+*******************************************************************************/
+
+typedef void *(*SkipList_data_copy_func) (
+  void **dest,
+  void *src);
+
+/*****************************************************************************//**
+  structure for a skip list
+
+ @param	length  the number of nodes in the list
+ @param	level   the number of levels in use
+ @param	seed    the state of the random level generator
+ @param	head    the first node on each level
+ @param	cmp     function to compare the data in the nodes
+ @param	free    function to free the data contained in the nodes, or NULL
+ @param	copy    function to copy the data contained in the nodes
+
+  note:
+        a zero filled SkipList with cmp set is a valid empty list
+*******************************************************************************/
+
+typedef struct {
+	size_t length;
+	size_t level;
+	unsigned long seed;
+	SkipList_node *head[SKIPLIST_MAXLEVEL];
+	SkipList_data_cmp_func cmp;
+	SkipList_data_free_func free;
+	SkipList_data_copy_func copy;
+} SkipList;
+
+/*****************************************************************************//**
+  type of function to be passed to the iterate functions
+
+ @param	list  the list being parsed
+ @param	node  the current node
+ @param	data  the data the current node holds
+ @param	extra the extra pointer passed to the itterate function
+
+ @return	null to continue the itterate loop
+          non null that stops the itterate loop and is returned by the iterate
+          function
+
+  note:
+        the current node can be deleted from the list
+*******************************************************************************/
+
+typedef void *(*SkipList_iterate_func) (
+	SkipList *list,
+	SkipList_node *node,
+	void *data,
+	void *extra);
+
+/*****************************************************************************//**
+  function to find a node in a skip list
+
+ @param	list  the list to find the node in
+ @param	data  the data to look for
+
+ @return	the first node that holds data equal to data
+					null if the data is not found
+
+  note:
+        the data passed to this function to look for is only bound by the data
+        compare function
+*******************************************************************************/
+
+SkipList_node *SkipList_find (
+	SkipList *list,
+	void *data);
+
+/*****************************************************************************//**
+  function to find the first node in a skip list not less than some data
+
+ @param	list  the list to search
+ @param	data  the data to look for
+
+ @return	the first node that holds data greater than or equal to data
+					null if all the data in the list is less than data
+*******************************************************************************/
+
+SkipList_node *SkipList_lower_bound (
+	SkipList *list,
+	void *data);
+
+/*****************************************************************************//**
+  function to add a node to a skip list
+
+ @param	list  the list to add the node to
+ @param	data  the data the node is to hold
+
+ @return	the new node
+          NULL if malloc fails
+
+  note:
+        data equal to data already in the list goes after it
+*******************************************************************************/
+
+SkipList_node *SkipList_insert (
+	SkipList *list,
+	void *data);
+
+/*****************************************************************************//**
+  funtion to delete a node from a skip list
+
+ @param	list  the list to delete the node from
+ @param	node  the node to delete
+
+ @return	the data the node held
+*******************************************************************************/
+
+void *SkipList_delete (
+	SkipList *list,
+	SkipList_node *node);
+
+/*****************************************************************************//**
+	function to count the nodes in a skip list
+
+ @param	list	the list
+
+ @return	the number of nodes in the list
+
+*******************************************************************************/
+
+size_t SkipList_length (
+	SkipList *list);
+
+/*****************************************************************************//**
+  function to iterate a skip list in order
+
+ @param	list 		  the list
+ @param	function  the function to pass each node to for processing
+ @param	extra		  extra data to pass to/from the proccessing function
+
+ @return	the non null returned from the proccessing function that stops the
+			iteration
+			NULL if the end of the list was reached
+*******************************************************************************/
+
+void *SkipList_iterate (
+	SkipList *list,
+	SkipList_iterate_func function,
+	void *extra);
+
+/*****************************************************************************//**
+  function to iterate the nodes of a skip list in a range in order
+
+ @param	list 		  the list
+ @param	lo        the lowest data to pass, or NULL to start at the first node
+ @param	hi        the data to stop before, or NULL to run to the last node
+ @param	function  the function to pass each node to for processing
+ @param	extra		  extra data to pass to/from the proccessing function
+
+ @return	the non null returned from the proccessing function that stops the
+			iteration
+			NULL if the end of the range was reached
+
+  note:
+        the nodes passed hold data greater than or equal to lo and less than hi
+*******************************************************************************/
+
+void *SkipList_range (
+	SkipList *list,
+	void *lo,
+	void *hi,
+	SkipList_iterate_func function,
+	void *extra);
+
+/*****************************************************************************//**
+  function to delete all the nodes in a skip list
+
+ @param	list  the list to delete all the nodes in
+
+ @return	nothing
+
+  note:
+        list->free is called for the data in each node if it is set
+*******************************************************************************/
+
+void SkipList_delete_all (
+	SkipList *list);
+
+/*****************************************************************************//**
+  function to copy a skip list into another skip list
+
+ @param	dest  the list to copy the nodes to
+ @param	src   the list to copy the nodes from
+
+ @return	null on success
+				the src node we were trying to copy when malloc or src->copy failed
+
+  note:
+        the data is copied with src->copy
+*******************************************************************************/
+
+SkipList_node *SkipList_copy (
+	SkipList *dest,
+	SkipList *src);
+
+#endif
@@ -0,0 +1,229 @@
+/*******************************************************************************
+	TWheel.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef TWheel_h
+#define TWheel_h
+
+#include <stddef.h>
+#include "LLPool.h"
+#include "CLList.h"
+
+/*****************************************************************************//**
+  number of bits of the time each level of a timing wheel covers, each level
+  has 1 << TWHEEL_BITS slots
+*******************************************************************************/
+
+#define TWHEEL_BITS 6
+#define TWHEEL_SLOTS (1 << TWHEEL_BITS)
+
+/*****************************************************************************//**
+  number of levels in a timing wheel, timers further out than
+  1 << (TWHEEL_BITS * TWHEEL_LEVELS) ticks wait in the last level and are
+  placed again as the wheel turns
+*******************************************************************************/
+
+#define TWHEEL_LEVELS 5
+
+/*****************************************************************************//**
+  structure for a timer in a timing wheel
+
+ @param	expire  the tick the timer fires at
+ @param	data    the data the timer was scheduled with
+ @param	slot    the slot the timer is in
+ @param	node    the timer's node in the slot
+ @param	level   the level of the slot, -1 while it is being fired
+*******************************************************************************/
+
+typedef struct {
+	unsigned long expire;
+	void *data;
+	CLList *slot;
+	CLList_node *node;
+	int level;
+} TWheel_timer;
+
+/*****************************************************************************//**
+  structure for a hierarchical timing wheel, level 0 has a slot for each of
+  the next TWHEEL_SLOTS ticks, each level above has slots TWHEEL_SLOTS times
+  as wide, when the lower level wraps the next slot of the level above is
+  cascaded down into it
+
+ @param	tick    the next tick advance will fire, every timer that expires
+                before it has fired
+ @param	length  the number of timers in the wheel
+ @param	count   the number of timers in each level
+ @param	pool    the pool the slots take their nodes from
+ @param	timers  the pool the timers are taken from
+ @param	slot    the slots of each level
+
+  note:
+        a zero filled TWheel is a valid empty wheel starting at tick 0
+        the ticks are whatever unit the caller counts time in
+*******************************************************************************/
+
+typedef struct {
+	unsigned long tick;
+	size_t length;
+	size_t count[TWHEEL_LEVELS];
+	LLPool pool;
+	LLPool timers;
+	CLList slot[TWHEEL_LEVELS][TWHEEL_SLOTS];
+} TWheel;
+
+/*****************************************************************************//**
+  type of function to pass to advance to be called for each timer that fires
+
+ @param	wheel  the wheel
+ @param	data   the data the timer was scheduled with
+ @param	extra  the extra pointer passed to advance
+
+ @return	nothing
+
+  note:
+        the function may schedule and cancel timers, including ones due in
+        the same advance
+*******************************************************************************/
+
+typedef void (*TWheel_expire_func) (
+	TWheel *wheel,
+	void *data,
+	void *extra);
+
+/*****************************************************************************//**
+  type of a function to pass to the delete functions to free the data
+
+ @param	data  pointer to the data to be free'ed
+
+ @return	nothing
+
+  note:
+        free() can be used if the data is a simple type
+*******************************************************************************/
+
+typedef void (*TWheel_data_free_func) (
+  void *data);
+
+/*****************************************************************************//**
+	function to schedule a timer in a timing wheel
+
+ @param	wheel		the wheel
+ @param	expire	the tick the timer fires at
+ @param	data		the data to pass to the expire function
+
+ @return	the timer, it stays valid until it fires or is canceled
+				NULL on error
+
+  note:
+        a timer that expires before the wheel's tick fires on the next advance
+*******************************************************************************/
+
+TWheel_timer *TWheel_schedule (
+	TWheel * wheel,
+	unsigned long expire,
+	void *data);
+
+/*****************************************************************************//**
+	function to move a timer in a timing wheel to a new tick
+
+ @param	wheel		the wheel
+ @param	timer		the timer
+ @param	expire	the new tick the timer fires at
+
+ @return	0 on success
+				1 on error, the timer is canceled
+
+  note:
+        the node the timer gives up is reused, so this does not fail unless
+        something else took it first
+*******************************************************************************/
+
+int TWheel_reschedule (
+	TWheel * wheel,
+	TWheel_timer * timer,
+	unsigned long expire);
+
+/*****************************************************************************//**
+	function to cancel a timer in a timing wheel
+
+ @param	wheel	the wheel
+ @param	timer	the timer
+
+ @return	the data the timer was scheduled with
+
+*******************************************************************************/
+
+void *TWheel_cancel (
+	TWheel * wheel,
+	TWheel_timer * timer);
+
+/*****************************************************************************//**
+	function to turn a timing wheel up to a tick and fire every timer that
+	expires by then
+
+ @param	wheel		the wheel
+ @param	now			the tick to turn the wheel to
+ @param	function	the function to call for each timer that fires
+ @param	extra		extra data to pass to the function
+
+ @return	the number of timers fired
+
+  note:
+        the timers fire in the order of their ticks, the timers are freed
+        before the function is called
+*******************************************************************************/
+
+size_t TWheel_advance (
+	TWheel * wheel,
+	unsigned long now,
+	TWheel_expire_func function,
+	void *extra);
+
+/*****************************************************************************//**
+	function to count the timers in a timing wheel
+
+ @param	wheel	the wheel
+
+ @return	the number of timers in the wheel
+
+*******************************************************************************/
+
+size_t TWheel_length (
+	TWheel * wheel);
+
+/*****************************************************************************//**
+	function to cancel all the timers in a timing wheel and free its memory
+
+ @param	wheel		the wheel
+ @param	function	the function to call to free the data, or NULL
+
+ @return	nothing
+
+  note:
+        the wheel keeps its tick
+*******************************************************************************/
+
+void TWheel_delete_all (
+	TWheel * wheel,
+	TWheel_data_free_func function);
+
+#endif
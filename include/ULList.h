@@ -0,0 +1,339 @@
+/*******************************************************************************
+	ULList.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef ULList_h
+#define ULList_h
+
+#include "LLPool.h"
+
+/*****************************************************************************//**
+  the number of data pointers each node of an unrolled linked list holds
+*******************************************************************************/
+
+#define ULLIST_NODESIZE 16
+
+/*****************************************************************************//**
+  structure for an unrolled double linked list node
+
+ @param	prev    the previous node in the list
+ @param	next    the next node in the list
+ @param	used    the number of data pointers in use
+ @param	data    the data the node holds, data[0] to data[used - 1]
+*******************************************************************************/
+
+typedef struct ULList_node_tab {
+	struct ULList_node_tab *prev;
+	struct ULList_node_tab *next;
+	size_t used;
+	void *data[ULLIST_NODESIZE];
+} ULList_node;
+
+/*****************************************************************************//**
+  structure for an unrolled double linked list
+
+ @param	length  the number of data pointers in the list
+ @param	head    the first node in the list
+ @param	tail    the last node in the list
+ @param	pool    the pool to take nodes from, NULL to use malloc
+
+  note:
+        a place in the list is a node and an index into the node's data,
+        inserting into or deleting from a node moves the data after the index
+        and may move data to or from the neighbouring nodes, so any node and
+        index held across an insert or delete must be looked up again
+*******************************************************************************/
+
+typedef struct {
+	size_t length;
+	ULList_node *head;
+	ULList_node *tail;
+	LLPool *pool;
+} ULList;
+
+/*****************************************************************************//**
+  type of function to be passed to the iterate function
+
+ @param	list  the list being parsed
+ @param	node  the current node
+ @param	index the index of the data in the current node
+ @param	data  the data
+ @param	extra the extra pointer passed to the itterate function
+
+ @return	null to continue the itterate loop
+          non null that stops the itterate loop and is returned by the iterate
+          function
+*******************************************************************************/
+
+typedef void *(*ULList_iterate_func) (
+	ULList *list,
+	ULList_node *node,
+	size_t index,
+	void *data,
+	void *extra);
+
+/*****************************************************************************//**
+  type of a function to pass to the delete functions to free the data
+
+ @param	data  pointer to the data to be free'ed
+
+ @return	nothing
+
+  note:
+        free() can be used if the data is a simple type
+*******************************************************************************/
+
+typedef void (*ULList_data_free_func) (
+  void *data);
+
+/*****************************************************************************//**
+  type of function to pass to the mergesort to compare the data
+
+ @param	data1   the first data pointer to be compared
+ @param	data2   the second data pointer to be compared
+
+ @return	less than 0 if data1 is less than data2
+        0 if data1 is equal to data2
+        greater than 0 if data1 is greater than data2
+
+   note
+        if data is a char pointer strcmp() can be passed
+*******************************************************************************/
+
+typedef int (*ULList_data_cmp_func) (
+  void *data1,
+  void *data2);
+
+/*****************************************************************************//**
+	function to add data to the head of an unrolled linked list
+
+ @param	list	the linked list
+ @param	data	the data you wish to store in the linked list
+
+ @return	the node that holds the data, the data is at index 0
+				NULL on error
+
+*******************************************************************************/
+
+ULList_node *ULList_prepend (
+	ULList *list,
+	void *data);
+
+/*****************************************************************************//**
+	function to add data to the tail of an unrolled linked list
+
+ @param	list	the linked list
+ @param	data	the data you wish to store in the linked list
+
+ @return	the node that holds the data, the data is at index used - 1
+				NULL on error
+
+*******************************************************************************/
+
+ULList_node *ULList_append (
+	ULList *list,
+	void *data);
+
+/*****************************************************************************//**
+	function to add data after any data in an unrolled linked list
+
+ @param	list	the linked list
+ @param	node	the node holding the data you wish to place the new data after
+ @param	index	the index of that data in the node
+ @param	data	the data you wish to store in the linked list
+ @param	newindex	set to the index of the new data in the node, or NULL
+
+ @return	the node that holds the new data
+				NULL on error
+
+  note:
+        if node is null or the list is empty the data will be appended to
+        the list
+        a full node is split in half, so the new data may be in a new node
+        at another index, newindex says where it is
+*******************************************************************************/
+
+ULList_node *ULList_insert_after (
+	ULList *list,
+	ULList_node *node,
+	size_t index,
+	void *data,
+	size_t *newindex);
+
+/*****************************************************************************//**
+	function to add data before any data in an unrolled linked list
+
+ @param	list	the linked list
+ @param	node	the node holding the data you wish to place the new data before
+ @param	index	the index of that data in the node
+ @param	data	the data you wish to store in the linked list
+ @param	newindex	set to the index of the new data in the node, or NULL
+
+ @return	the node that holds the new data
+				NULL on error
+
+  note:
+        if node is null or the list is empty the data will be prepended to
+        the list
+        a full node is split in half, so the new data may be in a new node
+        at another index, newindex says where it is
+*******************************************************************************/
+
+ULList_node *ULList_insert_before (
+	ULList *list,
+	ULList_node *node,
+	size_t index,
+	void *data,
+	size_t *newindex);
+
+/*****************************************************************************//**
+	function to delete data from an unrolled linked list
+
+ @param	list	the linked list
+ @param	node	the node holding the data you wish to delete
+ @param	index	the index of the data in the node
+
+ @return	the data
+
+*******************************************************************************/
+
+void *ULList_delete (
+	ULList *list,
+	ULList_node *node,
+	size_t index);
+
+/*****************************************************************************//**
+	function to count the data in an unrolled linked list
+
+ @param	list	the linked list
+
+ @return	the number of data pointers in the linked list
+
+*******************************************************************************/
+
+size_t ULList_length (
+	ULList *list);
+
+/*****************************************************************************//**
+	function to iterate an unrolled linked list
+
+ @param	list 		the linked list
+ @param	function	the function to pass each data to for processing
+ @param	extra		extra data to pass to/from the proccessing function
+
+ @return	the non null returned from the proccessing function that stops the
+			iteration
+			NULL if the end of the linked list was reached
+
+  note:
+        the proccessing function must not insert into or delete from the list
+
+*******************************************************************************/
+
+void *ULList_iterate (
+	ULList *list,
+	ULList_iterate_func function,
+	void *extra);
+
+/*****************************************************************************//**
+	function to delete all the nodes in an unrolled linked list
+
+ @param	list		the linked list
+ @param	function	the function to call to free the data
+
+ @return	nothing
+
+*******************************************************************************/
+
+void ULList_delete_all (
+	ULList *list,
+	ULList_data_free_func function);
+
+/*****************************************************************************//**
+	function to move another unrolled linked list to the head of an unrolled
+	linked list
+
+ @param	dest	the linked list you want to move the src to
+ @param	src		the linked list you want to move to the dest
+
+ @return	nothing
+
+*******************************************************************************/
+
+void ULList_prepend_list (
+	ULList *dest,
+	ULList *src);
+
+/*****************************************************************************//**
+	function to move another unrolled linked list to the tail of an unrolled
+	linked list
+
+ @param	dest	the linked list you want to move the src to
+ @param	src		the linked list you want to move to the dest
+
+ @return	nothing
+
+*******************************************************************************/
+
+void ULList_append_list (
+	ULList *dest,
+	ULList *src);
+
+/*****************************************************************************//**
+	function to move another unrolled linked list to the middle of an unrolled
+	linked list, after a particular node
+
+ @param	dest	the linked list you want to move the src to
+ @param	src		the linked list you want to move to the dest
+ @param	node	the node you wish to insert src after
+
+ @return	nothing
+
+	if node is null src is appended to dest
+
+*******************************************************************************/
+
+void ULList_insert_list_after (
+	ULList *dest,
+	ULList *src,
+	ULList_node *node);
+
+/*****************************************************************************//**
+	function to sort an unrolled linked list
+
+ @param	list		the linked list to sort
+ @param	cmp_func	function to compare the data
+
+ @return	0 on success
+				non zero if memory could not be allocated, the list is left as it was
+
+	Notes:
+				the sort is stable
+				the sorted list is packed into full nodes
+
+*******************************************************************************/
+
+int ULList_sort (
+	ULList *list,
+	ULList_data_cmp_func cmp_func);
+
+#endif
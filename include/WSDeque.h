@@ -0,0 +1,173 @@
+/*******************************************************************************
+	WSDeque.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef WSDeque_h
+#define WSDeque_h
+
+#include <stddef.h>
+
+/*****************************************************************************//**
+  number of slots a work stealing deque starts with
+*******************************************************************************/
+
+#define WSDEQUE_SIZE 64
+
+/*****************************************************************************//**
+  size of a cache line, the top and bottom are kept this far apart so the
+  owner and the thieves do not fight over one line
+*******************************************************************************/
+
+#define WSDEQUE_CACHELINE 64
+
+/*****************************************************************************//**
+  structure for the slots of a work stealing deque
+
+ @param	size  the number of slots, a power of 2
+ @param	old   the smaller array this one replaced, kept for thieves that
+              still read it
+ @param	slot  the slots
+
+  note:
+        the array is allocated with room for size slots
+*******************************************************************************/
+
+typedef struct WSDeque_array_tab {
+	size_t size;
+	struct WSDeque_array_tab *old;
+	void *volatile slot[1];
+} WSDeque_array;
+
+/*****************************************************************************//**
+  structure for a Chase / Lev work stealing deque, one owner thread pushes
+  and pops at the bottom while any thread can steal from the top
+
+ @param	top     the position of the oldest item, moved by steals and by the
+                owner taking the last item
+ @param	bottom  the position after the newest item, only the owner writes it
+ @param	array   the slots, allocated on the first push and doubled when full
+
+  note:
+        a zero filled WSDeque is a valid empty deque
+        NULL can not be pushed, it is what pop and steal return when they
+        get nothing
+*******************************************************************************/
+
+typedef struct {
+	volatile long top __attribute__ ((aligned (WSDEQUE_CACHELINE)));
+	volatile long bottom __attribute__ ((aligned (WSDEQUE_CACHELINE)));
+	WSDeque_array *volatile array;
+} WSDeque;
+
+/*****************************************************************************//**
+  type of a function to pass to the delete functions to free the data
+
+ @param	data  pointer to the data to be free'ed
+
+ @return	nothing
+
+  note:
+        free() can be used if the data is a simple type
+*******************************************************************************/
+
+typedef void (*WSDeque_data_free_func) (
+  void *data);
+
+/*****************************************************************************//**
+	function to push data onto the bottom of a work stealing deque
+
+ @param	list	the deque
+ @param	data	the data you wish to store in the deque
+
+ @return	0 on success
+				-1 on error
+
+  note:
+        only the owner may call this
+*******************************************************************************/
+
+int WSDeque_push (
+	WSDeque * list,
+	void *data);
+
+/*****************************************************************************//**
+	function to pop the newest data from the bottom of a work stealing deque
+
+ @param	list	the deque
+
+ @return	the data
+				NULL if the deque is empty or a thief took the last item
+
+  note:
+        only the owner may call this
+*******************************************************************************/
+
+void *WSDeque_pop (
+	WSDeque * list);
+
+/*****************************************************************************//**
+	function to steal the oldest data from the top of a work stealing deque
+
+ @param	list	the deque
+
+ @return	the data
+				NULL if the deque is empty or another thread got the item first
+
+  note:
+        any thread may call this
+*******************************************************************************/
+
+void *WSDeque_steal (
+	WSDeque * list);
+
+/*****************************************************************************//**
+	function to count the items in a work stealing deque
+
+ @param	list	the deque
+
+ @return	the number of items in the deque
+
+  note:
+        with other threads working on the deque the count is only a snapshot
+*******************************************************************************/
+
+size_t WSDeque_length (
+	WSDeque * list);
+
+/*****************************************************************************//**
+	function to delete all the items in a work stealing deque and free its
+	arrays
+
+ @param	list		the deque
+ @param	function	the function to call to free the data, or NULL
+
+ @return	nothing
+
+  note:
+        no other thread may be using the deque
+*******************************************************************************/
+
+void WSDeque_delete_all (
+	WSDeque * list,
+	WSDeque_data_free_func function);
+
+#endif
@@ -0,0 +1,267 @@
+/*******************************************************************************
+	stackBuffer.h
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef stackBuffer_h
+#define stackBuffer_h
+
+#include <stddef.h>
+
+/*****************************************************************************//**
+  number of slots a stack buffer starts with
+*******************************************************************************/
+
+#define STACKBUFFER_SIZE 16
+
+/*****************************************************************************//**
+  structure for a stack kept in an array, the array backed twin of
+  stackLList
+
+ @param	length  the number of items in the stack
+ @param	size    the number of slots
+ @param	buffer  the slots, buffer[length - 1] is the top
+
+  note:
+        a zero filled stackBuffer is a valid empty stack
+        the buffer doubles when it is full and only gets smaller with
+        stackBuffer_shrink () or stackBuffer_delete_all (), so a stack that
+        stays about the same depth allocates nothing once it has grown
+*******************************************************************************/
+
+typedef struct {
+	size_t length;
+	size_t size;
+	void **buffer;
+} stackBuffer;
+
+/*****************************************************************************//**
+  type of function to be passed to the iterate function
+
+ @param	list   the stack being parsed
+ @param	index  the position of the current item, 0 is the top
+ @param	data   the current item
+ @param	extra  the extra pointer passed to the itterate function
+
+ @return	null to continue the itterate loop
+          non null that stops the itterate loop and is returned by the iterate
+          function
+*******************************************************************************/
+
+typedef void *(*stackBuffer_iterate_func) (
+	stackBuffer *list,
+	size_t index,
+	void *data,
+	void *extra);
+
+/*****************************************************************************//**
+  type of a function to pass to the delete functions to free the data
+
+ @param	data  pointer to the data to be free'ed
+
+ @return	nothing
+
+  note:
+        free() can be used if the data is a simple type
+*******************************************************************************/
+
+typedef void (*stackBuffer_data_free_func) (
+  void *data);
+
+/*****************************************************************************//**
+	function to push data onto a stack
+
+ @param	list	the stack
+ @param	data	the data you wish to store in the stack
+
+ @return	the data
+				NULL on error
+
+*******************************************************************************/
+
+void *stackBuffer_push (
+	stackBuffer * list,
+	void *data);
+
+/*****************************************************************************//**
+	function to pop data from a stack
+
+ @param	list	the stack
+
+ @return	the data
+				NULL if the stack is empty
+
+*******************************************************************************/
+
+void *stackBuffer_pop (
+	stackBuffer * list);
+
+/*****************************************************************************//**
+	function to read the top of a stack without popping it
+
+ @param	list	the stack
+
+ @return	the data
+				NULL if the stack is empty
+
+*******************************************************************************/
+
+void *stackBuffer_read_head (
+	stackBuffer * list);
+
+/*****************************************************************************//**
+	function to count the items in a stack
+
+ @param	list	the stack
+
+ @return	the number of items in the stack
+
+*******************************************************************************/
+
+size_t stackBuffer_length (
+	stackBuffer * list);
+
+/*****************************************************************************//**
+	function to make room in a stack so it can hold a number of items without
+	growing
+
+ @param	list	the stack
+ @param	count	the number of items the stack must hold
+
+ @return	0 on success
+				1 on error
+
+  note:
+        the buffer is never made smaller here, use stackBuffer_shrink ()
+*******************************************************************************/
+
+int stackBuffer_reserve (
+	stackBuffer * list,
+	size_t count);
+
+/*****************************************************************************//**
+	function to give back the slots a stack is not using
+
+ @param	list	the stack
+
+ @return	0 on success
+				1 on error, the buffer is left as it was
+
+  note:
+        an empty stack frees its buffer
+*******************************************************************************/
+
+int stackBuffer_shrink (
+	stackBuffer * list);
+
+/*****************************************************************************//**
+	function to iterate a stack from the top down
+
+ @param	list 		the stack
+ @param	function	the function to pass each item to for processing
+ @param	extra		extra data to pass to/from the proccessing function
+
+ @return	the non null returned from the proccessing function that stops the
+				iteration
+				NULL if the bottom of the stack was reached
+
+  note:
+        the stack must not be changed during the iteration
+*******************************************************************************/
+
+void *stackBuffer_iterate (
+	stackBuffer * list,
+	stackBuffer_iterate_func function,
+	void *extra);
+
+/*****************************************************************************//**
+	function to delete all the items in a stack and free its buffer
+
+ @param	list		the stack
+ @param	function	the function to call to free the data, or NULL
+
+ @return	nothing
+
+*******************************************************************************/
+
+void stackBuffer_delete_all (
+	stackBuffer * list,
+	stackBuffer_data_free_func function);
+
+/*****************************************************************************//**
+	function to move another stack to the top of a stack
+
+ @param	dest	the stack you want to move the src to
+ @param	src		the stack you want to move to the dest
+
+ @return	0 on success
+				1 on error, nothing is moved
+
+  note:
+        the src keeps its order, its top becomes the top of the dest, the src
+        is left empty
+*******************************************************************************/
+
+int stackBuffer_push_list (
+	stackBuffer * dest,
+	stackBuffer * src);
+
+/*****************************************************************************//**
+	function to push the data in an array onto a stack
+
+ @param	list	the stack
+ @param	array	the data you wish to store in the stack
+ @param	count	the number of entries in the array
+
+ @return	0 on success
+				1 on error, nothing is pushed
+
+	notes:
+				the same as pushing each entry in turn, array[count - 1] ends up on
+				top
+
+*******************************************************************************/
+
+int stackBuffer_push_array (
+	stackBuffer * list,
+	void **array,
+	size_t count);
+
+/*****************************************************************************//**
+	function to copy the data in a stack to an array
+
+ @param	list	the stack
+ @param	array	the array to fill, it must have room for the length of the
+					stack
+
+ @return	the number of entries filled in
+
+	notes:
+				the array is filled from the top down, the order the data would be
+				popped in
+
+*******************************************************************************/
+
+size_t stackBuffer_to_array (
+	stackBuffer * list,
+	void **array);
+
+#endif
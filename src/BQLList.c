@@ -0,0 +1,366 @@
+/*******************************************************************************
+	BQLList.c
+
+	blocking fifo
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include "../include/QLList.h"
+#include "../include/BQLList.h"
+
+/*******************************************************************************
+	function to set up a blocking que
+
+	Arguments:
+				list	the que
+				high	the number of items pushes wait at, 0 for no limit
+				low		the number of items waiting pushes carry on at, it must be
+							less than high
+
+	returns:
+				0 on success
+				1 on error
+
+	notes:
+				a zero filled mutex is not a valid mutex everywhere, so unlike the
+				other lists this one can not be used without setting it up
+				timed pulls wait on the monotonic clock so setting the wall clock
+				does not cut them short or make them hang
+
+*******************************************************************************/
+
+int BQLList_init (
+	BQLList * list,
+	size_t high,
+	size_t low)
+{
+	pthread_condattr_t attr;
+	int failed;
+
+	if (high && low >= high)
+		return 1;
+
+	memset (list, 0, sizeof (BQLList));
+	list->high = high;
+	list->low = low;
+
+	if (pthread_mutex_init (&list->mutex, NULL))
+		return 1;
+
+	/***** only timed pulls wait on readable, on the monotonic clock *****/
+
+	if (pthread_condattr_init (&attr)) {
+		pthread_mutex_destroy (&list->mutex);
+		return 1;
+	}
+
+	failed = pthread_condattr_setclock (&attr, CLOCK_MONOTONIC) ||
+					 pthread_cond_init (&list->readable, &attr);
+
+	pthread_condattr_destroy (&attr);
+
+	if (failed) {
+		pthread_mutex_destroy (&list->mutex);
+		return 1;
+	}
+
+	if (pthread_cond_init (&list->writable, NULL)) {
+		pthread_cond_destroy (&list->readable);
+		pthread_mutex_destroy (&list->mutex);
+		return 1;
+	}
+
+	return 0;
+}
+
+/*******************************************************************************
+	slave function to wait for the que to have something in it, the mutex
+	must be held
+
+	Arguments:
+				list	the que
+				msec	the most milliseconds to wait, 0 to not wait, less than 0
+							to wait for ever
+
+	returns:
+				0 if the que has something in it
+				1 if the timeout passed with the que empty
+
+*******************************************************************************/
+
+static int BQLList_wait_readable (
+	BQLList * list,
+	long msec)
+{
+	struct timespec until;
+
+	if (msec < 0) {
+		while (!list->list.length)
+			pthread_cond_wait (&list->readable, &list->mutex);
+
+		return 0;
+	}
+
+	if (list->list.length)
+		return 0;
+
+	if (!msec)
+		return 1;
+
+	clock_gettime (CLOCK_MONOTONIC, &until);
+	until.tv_sec += msec / 1000;
+	until.tv_nsec += (msec % 1000) * 1000000L;
+
+	if (until.tv_nsec >= 1000000000L) {
+		until.tv_sec++;
+		until.tv_nsec -= 1000000000L;
+	}
+
+	while (!list->list.length) {
+		if (ETIMEDOUT == pthread_cond_timedwait (&list->readable, &list->mutex,
+																						 &until))
+			return !list->list.length;
+	}
+
+	return 0;
+}
+
+/*******************************************************************************
+	slave function to let waiting pushes go once the que has drained to the
+	low mark, the mutex must be held
+
+	Arguments:
+				list	the que
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+static void BQLList_drained (
+	BQLList * list)
+{
+
+	if (list->full && list->list.length <= list->low) {
+		list->full = 0;
+		pthread_cond_broadcast (&list->writable);
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	function to push data onto a blocking que, waiting while it is full
+
+	Arguments:
+				list	the que
+				data	the data you wish to store in the que
+
+	returns:
+				the data
+				NULL on error
+
+	notes:
+				once the que reaches the high mark pushes wait until it is
+				back down to the low mark, not just below the high mark, so a
+				fast producer wakes up once per batch and not once per item
+
+*******************************************************************************/
+
+void *BQLList_push (
+	BQLList * list,
+	void *data)
+{
+	void *result = NULL;
+
+	pthread_mutex_lock (&list->mutex);
+
+	while (list->full)
+		pthread_cond_wait (&list->writable, &list->mutex);
+
+	if ((result = QLList_push (&list->list, data))) {
+		if (list->high && list->list.length >= list->high)
+			list->full = 1;
+
+		pthread_cond_signal (&list->readable);
+	}
+
+	pthread_mutex_unlock (&list->mutex);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to pull data from a blocking que, waiting for some
+
+	Arguments:
+				list	the que
+
+	returns:
+				the data the node held
+
+*******************************************************************************/
+
+void *BQLList_pull (
+	BQLList * list)
+{
+	void *result = NULL;
+
+	result = BQLList_pull_timed (list, -1);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to pull data from a blocking que, waiting for some no longer than
+	a timeout
+
+	Arguments:
+				list	the que
+				msec	the most milliseconds to wait, 0 to not wait, less than 0 to
+							wait for ever
+
+	returns:
+				the data the node held
+				NULL if the timeout passed with the que empty
+
+*******************************************************************************/
+
+void *BQLList_pull_timed (
+	BQLList * list,
+	long msec)
+{
+	void *result = NULL;
+
+	pthread_mutex_lock (&list->mutex);
+
+	if (!BQLList_wait_readable (list, msec)) {
+		result = QLList_pull (&list->list);
+		BQLList_drained (list);
+	}
+
+	pthread_mutex_unlock (&list->mutex);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to pull up to a number of items from a blocking que under one
+	lock
+
+	Arguments:
+				list	the que
+				array	the array to fill, in the order the items were pushed
+				max		the most items to pull
+				msec	the most milliseconds to wait for the first item, 0 to not
+							wait, less than 0 to wait for ever
+
+	returns:
+				the number of items pulled
+				0 if the timeout passed with the que empty
+
+	notes:
+				only the first item is waited for, whatever else is in the que
+				then is taken without waiting for more
+
+*******************************************************************************/
+
+size_t BQLList_pull_batch (
+	BQLList * list,
+	void **array,
+	size_t max,
+	long msec)
+{
+	size_t result = 0;
+
+	if (!max)
+		return 0;
+
+	pthread_mutex_lock (&list->mutex);
+
+	if (!BQLList_wait_readable (list, msec)) {
+		while (result < max && list->list.length)
+			array[result++] = QLList_pull (&list->list);
+
+		BQLList_drained (list);
+	}
+
+	pthread_mutex_unlock (&list->mutex);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to count the items in a blocking que
+
+	Arguments:
+				list	the que
+
+	returns:
+				the number of items in the que
+
+*******************************************************************************/
+
+size_t BQLList_length (
+	BQLList * list)
+{
+	size_t result;
+
+	pthread_mutex_lock (&list->mutex);
+	result = list->list.length;
+	pthread_mutex_unlock (&list->mutex);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete all the items in a blocking que and tear it down
+
+	Arguments:
+				list		the que
+				function	the function to call to free the data, or NULL
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void BQLList_delete_all (
+	BQLList * list,
+	QLList_data_free_func function)
+{
+
+	QLList_delete_all (&list->list, function);
+
+	pthread_cond_destroy (&list->writable);
+	pthread_cond_destroy (&list->readable);
+	pthread_mutex_destroy (&list->mutex);
+
+	list->full = 0;
+
+	return;
+}
@@ -60,7 +60,7 @@ BSTree_node *BSTree_find(
   /***** loop till we find matched data  or there is no match found *****/
   
   for (node = *next ;
-       node && (cmp = tree->cmp(node->data, data)) ;
+       node && (cmp = tree->cmp(data, node->data)) ;
        node = *next) {
     
     /***** left or right? *****/
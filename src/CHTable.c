@@ -0,0 +1,496 @@
+/*******************************************************************************
+	CHTable.c
+
+	sharded concurrent hash table
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "../include/LLPool.h"
+#include "../include/CHTable.h"
+
+/***** the shard for a hash, from the high bits so the buckets get the low *****/
+
+#define SHARD(table, hash) \
+	(&(table)->shard[((hash) >> (sizeof (size_t) * 4)) & (CHTABLE_SHARDS - 1)])
+
+/*******************************************************************************
+	slave function to hash data, the user's hash is mixed so both the high
+	bits that pick the shard and the low bits that pick the bucket depend on
+	all of it
+
+	returns:
+				the hash
+*******************************************************************************/
+
+static size_t CHTable_hash (
+	CHTable *table,
+	void *data)
+{
+	size_t result = table->hash (data);
+
+	result *= (size_t) 0x9e3779b97f4a7c15ULL;
+	result ^= result >> (sizeof (size_t) * 4 - 3);
+
+	return result;
+}
+
+/*******************************************************************************
+	slave function to get the bucket the entries for a hash are kept in, the
+	old table's while that bucket there has not been moved yet
+
+	returns:
+				the bucket
+*******************************************************************************/
+
+static CHTable_node **CHTable_bucket (
+	CHTable_shard *shard,
+	size_t hash)
+{
+	CHTable_node **result = NULL;
+	size_t i;
+
+	if (shard->old && (i = hash & (shard->oldsize - 1)) >= shard->moved)
+		result = &shard->old[i];
+	else
+		result = &shard->table[hash & (shard->size - 1)];
+
+	return result;
+}
+
+/*******************************************************************************
+	slave function to find the place that points to the entry for data
+
+	returns:
+				the pointer to the entry, *result is NULL if the data is not there
+				NULL if the shard has no table yet
+*******************************************************************************/
+
+static CHTable_node **CHTable_lookup (
+	CHTable *table,
+	CHTable_shard *shard,
+	void *data,
+	size_t hash)
+{
+	CHTable_node **result = NULL;
+
+	if (!shard->table)
+		return NULL;
+
+	for (result = CHTable_bucket (shard, hash); *result;
+			 result = &(*result)->next) {
+		if ((*result)->hash == hash && !table->cmp ((*result)->data, data))
+			break;
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	slave function to move a few buckets of the old table of a growing shard
+	to the new one, the shard must be locked for writing
+
+	returns:
+				nothing
+*******************************************************************************/
+
+static void CHTable_migrate (
+	CHTable_shard *shard)
+{
+	CHTable_node *node = NULL;
+	CHTable_node **bucket = NULL;
+	int i;
+
+	for (i = 0; i < CHTABLE_MIGRATE && shard->moved < shard->oldsize; i++) {
+		while ((node = shard->old[shard->moved])) {
+			shard->old[shard->moved] = node->next;
+			bucket = &shard->table[node->hash & (shard->size - 1)];
+			node->next = *bucket;
+			*bucket = node;
+		}
+
+		shard->moved++;
+	}
+
+	if (shard->moved == shard->oldsize) {
+		free (shard->old);
+		shard->old = NULL;
+		shard->oldsize = 0;
+		shard->moved = 0;
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to start growing a shard, the current table becomes the
+	old table and is moved to one twice the size a few buckets at a time
+
+	returns:
+				nothing
+
+	notes:
+				if the new table can not be allocated the shard just keeps its
+				table with longer chains
+
+*******************************************************************************/
+
+static void CHTable_grow (
+	CHTable_shard *shard)
+{
+	size_t size = shard->size ? shard->size * 2 : CHTABLE_BUCKETS;
+	CHTable_node **table = NULL;
+
+	if (!(table = calloc (size, sizeof (CHTable_node *))))
+		return;
+
+	if (shard->table) {
+		shard->old = shard->table;
+		shard->oldsize = shard->size;
+		shard->moved = 0;
+	}
+
+	shard->table = table;
+	shard->size = size;
+
+	return;
+}
+
+/*******************************************************************************
+	function to set up a concurrent hash table
+
+	Arguments:
+				table	the table, with hash, cmp and free set
+
+	returns:
+				0 on success
+				1 on error
+
+*******************************************************************************/
+
+int CHTable_init (
+	CHTable * table)
+{
+	CHTable_shard *shard = NULL;
+	int i;
+
+	for (i = 0; i < CHTABLE_SHARDS; i++) {
+		shard = &table->shard[i];
+		memset (shard, 0, sizeof (CHTable_shard));
+
+		if (pthread_rwlock_init (&shard->lock, NULL)) {
+			while (i--)
+				pthread_rwlock_destroy (&table->shard[i].lock);
+
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/*******************************************************************************
+	function to find data in a concurrent hash table
+
+	Arguments:
+				table	the table
+				data	data equal to the data to find
+
+	returns:
+				the data in the table
+				NULL if it is not in the table
+
+*******************************************************************************/
+
+void *CHTable_find (
+	CHTable * table,
+	void *data)
+{
+	size_t hash = CHTable_hash (table, data);
+	CHTable_shard *shard = SHARD (table, hash);
+	CHTable_node **node = NULL;
+	void *result = NULL;
+
+	pthread_rwlock_rdlock (&shard->lock);
+
+	if ((node = CHTable_lookup (table, shard, data, hash)) && *node)
+		result = (*node)->data;
+
+	pthread_rwlock_unlock (&shard->lock);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to insert data in a concurrent hash table
+
+	Arguments:
+				table	the table
+				data	the data to insert
+
+	returns:
+				the data in the table, if equal data was already there it is
+				returned and data is not inserted
+				NULL on error
+
+*******************************************************************************/
+
+void *CHTable_insert (
+	CHTable * table,
+	void *data)
+{
+	size_t hash = CHTable_hash (table, data);
+	CHTable_shard *shard = SHARD (table, hash);
+	CHTable_node **bucket = NULL;
+	CHTable_node *node = NULL;
+	void *result = NULL;
+
+	pthread_rwlock_wrlock (&shard->lock);
+
+	if (shard->old)
+		CHTable_migrate (shard);
+
+	if ((bucket = CHTable_lookup (table, shard, data, hash)) && *bucket)
+		result = (*bucket)->data;
+
+	/***** more entries than buckets? start growing unless already *****/
+
+	else {
+		if (!shard->old && shard->length >= shard->size)
+			CHTable_grow (shard);
+
+		/***** link it in where lookups look, maybe the old table *****/
+
+		if (shard->table &&
+				(node = LLPool_alloc (&shard->pool, sizeof (CHTable_node)))) {
+			bucket = CHTable_bucket (shard, hash);
+			node->hash = hash;
+			node->data = data;
+			node->next = *bucket;
+			*bucket = node;
+			shard->length++;
+			result = data;
+		}
+	}
+
+	pthread_rwlock_unlock (&shard->lock);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete data from a concurrent hash table
+
+	Arguments:
+				table	the table
+				data	data equal to the data to delete
+
+	returns:
+				the data that was in the table, it is not passed to table->free
+				NULL if it is not in the table
+
+*******************************************************************************/
+
+void *CHTable_delete (
+	CHTable * table,
+	void *data)
+{
+	size_t hash = CHTable_hash (table, data);
+	CHTable_shard *shard = SHARD (table, hash);
+	CHTable_node **bucket = NULL;
+	CHTable_node *node = NULL;
+	void *result = NULL;
+
+	pthread_rwlock_wrlock (&shard->lock);
+
+	if (shard->old)
+		CHTable_migrate (shard);
+
+	if ((bucket = CHTable_lookup (table, shard, data, hash)) && (node = *bucket)) {
+		*bucket = node->next;
+		result = node->data;
+		LLPool_free (&shard->pool, node);
+		shard->length--;
+	}
+
+	pthread_rwlock_unlock (&shard->lock);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to count the data in a concurrent hash table
+
+	Arguments:
+				table	the table
+
+	returns:
+				the number of data in the table
+
+*******************************************************************************/
+
+size_t CHTable_length (
+	CHTable * table)
+{
+	size_t result = 0;
+	int i;
+
+	for (i = 0; i < CHTABLE_SHARDS; i++) {
+		pthread_rwlock_rdlock (&table->shard[i].lock);
+		result += table->shard[i].length;
+		pthread_rwlock_unlock (&table->shard[i].lock);
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	slave function to pass each data in a list of buckets to an iterate
+	function
+
+	returns:
+				the non null returned from the proccessing function
+				NULL if the end of the buckets was reached
+*******************************************************************************/
+
+static void *CHTable_iterate_buckets (
+	CHTable *table,
+	CHTable_node **buckets,
+	size_t first,
+	size_t size,
+	CHTable_iterate_func function,
+	void *extra)
+{
+	CHTable_node *node = NULL;
+	void *result = NULL;
+	size_t i;
+
+	for (i = first; i < size && !result; i++) {
+		for (node = buckets[i]; node && !result; node = node->next)
+			result = function (table, node->data, extra);
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to iterate a concurrent hash table a shard at a time
+
+	Arguments:
+				table 		the table
+				function	the function to pass each data to for processing
+				extra		extra data to pass to/from the proccessing function
+
+	returns:
+				the non null returned from the proccessing function that stops the
+				iteration
+				NULL if the end of the table was reached
+
+*******************************************************************************/
+
+void *CHTable_iterate (
+	CHTable * table,
+	CHTable_iterate_func function,
+	void *extra)
+{
+	CHTable_shard *shard = NULL;
+	void *result = NULL;
+	int i;
+
+	for (i = 0; i < CHTABLE_SHARDS && !result; i++) {
+		shard = &table->shard[i];
+
+		pthread_rwlock_rdlock (&shard->lock);
+
+		result = CHTable_iterate_buckets (table, shard->table, 0, shard->size,
+																			function, extra);
+
+		if (!result && shard->old)
+			result = CHTable_iterate_buckets (table, shard->old, shard->moved,
+																				shard->oldsize, function, extra);
+
+		pthread_rwlock_unlock (&shard->lock);
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	slave function for CHTable_iterate () to pass each data to table->free
+
+	returns:
+				NULL
+*******************************************************************************/
+
+static void *CHTable_free_data (
+	CHTable *table,
+	void *data,
+	void *extra)
+{
+
+	(void) extra;
+	table->free (data);
+
+	return NULL;
+}
+
+/*******************************************************************************
+	function to delete all the data in a concurrent hash table and tear it
+	down
+
+	Arguments:
+				table	the table
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void CHTable_delete_all (
+	CHTable * table)
+{
+	CHTable_shard *shard = NULL;
+	int i;
+
+	if (table->free)
+		CHTable_iterate (table, CHTable_free_data, NULL);
+
+	for (i = 0; i < CHTABLE_SHARDS; i++) {
+		shard = &table->shard[i];
+
+		free (shard->table);
+		free (shard->old);
+		LLPool_delete_all (&shard->pool);
+		pthread_rwlock_destroy (&shard->lock);
+
+		shard->table = NULL;
+		shard->old = NULL;
+		shard->length = 0;
+		shard->size = 0;
+		shard->oldsize = 0;
+		shard->moved = 0;
+	}
+
+	return;
+}
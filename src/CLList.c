@@ -99,7 +99,7 @@ CLList_node *CLList_insert_after (
   CLList_node *new = NULL;
 
 
-	if ((new = malloc (sizeof (CLList_node)))) {
+	if ((new = LLPool_alloc (list->pool, sizeof (CLList_node)))) {
 
 		new->data = data;
 		new->next = NULL;
@@ -166,7 +166,7 @@ CLList_node *CLList_insert_before (
 	CLList_node *new = NULL;
 
 
-	if ((new = malloc (sizeof (CLList_node)))) {
+	if ((new = LLPool_alloc (list->pool, sizeof (CLList_node)))) {
 
 		new->data = data;
 		new->next = NULL;
@@ -301,7 +301,7 @@ void *CLList_delete_after (
     list->tail = node;
     list->head = node->next;
     
-		free (next);
+		LLPool_free (list->pool, next);
     
 		list->length--;
 	}
@@ -351,7 +351,7 @@ void *CLList_delete_before (
     list->head = node;
     list->tail = node->prev;
     
-		free (prev);
+		LLPool_free (list->pool, prev);
 		
 		list->length--;
 	}
@@ -885,3 +885,124 @@ CLList_node *CLList_insert_list_before_copy (
   return result;
 }
 
+/*******************************************************************************
+	function to add the data in an array to the tail of a circular linked list
+
+	Arguments:
+				list	the linked list
+				array	the data you wish to store in the linked list
+				count	the number of entries in the array
+
+	returns:
+				0 on success
+				1 on error, nothing is added
+
+	notes:
+				the same as appending each entry in turn, array[count - 1] becomes
+				the tail
+
+*******************************************************************************/
+
+int CLList_append_array (
+	CLList * list,
+	void **array,
+	size_t count)
+{
+	int result;
+
+	/***** remove the circle *****/
+
+	if (list->head) {
+		list->head->prev = NULL;
+		list->tail->next = NULL;
+	}
+
+	result = DLList_append_array ((DLList *) list, array, count);
+
+	/***** tie it in a circle *****/
+
+	if (list->head) {
+		list->head->prev = list->tail;
+		list->tail->next = list->head;
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to copy the data in a circular linked list to an array
+
+	Arguments:
+				list	the linked list
+				array	the array to fill, it must have room for the length of the
+							list
+
+	returns:
+				the number of entries filled in
+
+	notes:
+				the array is filled once round the circle starting at the head
+
+*******************************************************************************/
+
+size_t CLList_to_array (
+	CLList * list,
+	void **array)
+{
+	size_t result;
+
+	result = DLList_to_array ((DLList *) list, array);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to copy another list to the tail of a circular linked list, all or
+	nothing
+
+	Arguments:
+				dest		the linked list you want to copy the src to
+				src			the linked list you want to copy to the dest
+				copy_func	function to copy the data held in each node
+				free_func	function to free the copies made if a later one fails,
+										or NULL
+				arena		the arena to pass to copy_func, or NULL
+
+	returns:
+				0 on success
+				1 on error, nothing is added
+
+*******************************************************************************/
+
+int CLList_append_list_copy_arena (
+	CLList * dest,
+	CLList * src,
+	CLList_data_arena_copy_func copy_func,
+	CLList_data_free_func free_func,
+	LLArena * arena)
+{
+	int result;
+
+	/***** remove the circle *****/
+
+	if (dest->head) {
+		dest->head->prev = NULL;
+		dest->tail->next = NULL;
+	}
+
+	result = DLList_append_list_copy_arena (
+				(DLList *) dest,
+				(DLList *) src,
+				(DLList_data_arena_copy_func) copy_func,
+				(DLList_data_free_func) free_func,
+				arena);
+
+	/***** tie it in a circle *****/
+
+	if (dest->head) {
+		dest->head->prev = dest->tail;
+		dest->tail->next = dest->head;
+	}
+
+	return result;
+}
@@ -24,6 +24,7 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include "../include/DLList.h"
+#include "LLSort.h"
 
 
 /*******************************************************************************
@@ -45,7 +46,7 @@ DLList_node *DLList_prepend (
 {
 	DLList_node *new = NULL;
 
-	if ((new = malloc (sizeof (DLList_node)))) {
+	if ((new = LLPool_alloc (list->pool, sizeof (DLList_node)))) {
 
 		new->data = data;
 		new->next = list->head;
@@ -84,7 +85,7 @@ DLList_node *DLList_append (
 {
 	DLList_node *new = NULL;
 
-	if ((new = malloc (sizeof (DLList_node)))) {
+	if ((new = LLPool_alloc (list->pool, sizeof (DLList_node)))) {
 
 		new->data = data;
 		new->next = NULL;
@@ -130,7 +131,7 @@ DLList_node *DLList_insert_after (
 	DLList_node *new = NULL;
 
 
-	if ((new = malloc (sizeof (DLList_node)))) {
+	if ((new = LLPool_alloc (list->pool, sizeof (DLList_node)))) {
 
 		new->data = data;
 		new->next = NULL;
@@ -192,7 +193,7 @@ DLList_node *DLList_insert_before (
 	DLList_node *new = NULL;
 
 
-	if ((new = malloc (sizeof (DLList_node)))) {
+	if ((new = LLPool_alloc (list->pool, sizeof (DLList_node)))) {
 
 		new->data = data;
 		new->next = NULL;
@@ -274,7 +275,7 @@ void *DLList_delete (
 		node->next->prev = node->prev;
 	}
 
-	free (node);
+	LLPool_free (list->pool, node);
 	list->length--;
 
 	return result;
@@ -327,7 +328,7 @@ void *DLList_delete_after (
 			node->next = next->next;
 		}
 
-		free (next);
+		LLPool_free (list->pool, next);
     
 		list->length--;
 	}
@@ -382,7 +383,7 @@ void *DLList_delete_before (
 			node->prev = prev->prev;
 		}
 
-		free (prev);
+		LLPool_free (list->pool, prev);
 		
 		list->length--;
 	}
@@ -442,25 +443,6 @@ void *DLList_iterate (
 	return result;
 }
 
-/*******************************************************************************
-	slave function to delete all the nodes in a linked list
-*******************************************************************************/
-
-static void *DLList_delete_all_iterate (
-	DLList * list,
-	DLList_node * node,
-	void *data,
-	void *extra)
-{
-	DLList_data_free_func data_free = extra;
-
-	data_free (node->data);
-
-	DLList_delete (list, node);
-
-	return NULL;
-}
-
 /*******************************************************************************
 	function to delete all the nodes in a double linked list
 	
@@ -477,9 +459,27 @@ void DLList_delete_all (
 	DLList * list,
 	DLList_data_free_func data_free)
 {
+	DLList_node *node = NULL;
+	DLList_node *next = NULL;
+
+	for (node = list->head; node; node = next) {
+		next = node->next;
+
+		if (data_free)
+			data_free (node->data);
+
+		LLPool_free (list->pool, node);
+	}
+
+	list->head = NULL;
+	list->tail = NULL;
+	list->length = 0;
+
+	/***** was that the last node the pool handed out? release its slabs *****/
+
+	if (list->pool && !list->pool->used)
+		LLPool_delete_all (list->pool);
 
-	DLList_iterate (list, &DLList_delete_all_iterate, data_free);
-	
 	return;
 }
 
@@ -507,10 +507,12 @@ void DLList_prepend_list (
 	}
 
 	else {
-		
+
 		if (dest->head)
 			dest->head->prev = src->tail;
-		
+		else
+			dest->tail = src->tail;
+
 		src->tail->next = dest->head;
 		dest->head = src->head;
 	}
@@ -1005,3 +1007,638 @@ void DLList_sort (
   
 	return;
 }
+
+/*******************************************************************************
+	function to sort a double linked list, taking advantage of runs already in
+	the list
+
+	Arguments:
+				list		the linked list to sort
+				cmp_func	function to compare the data in 2 nodes
+
+	Returns:
+				nothing
+
+	Notes:
+				ascending and strictly descending runs are merged TimSort style with
+				galloping, a sorted or reversed list costs length - 1 compares
+				the sort is stable
+
+*******************************************************************************/
+
+void DLList_sort_adaptive (
+	DLList * list,
+	DLList_data_cmp_func cmp_func)
+{
+	LLSort_layout layout = {
+		offsetof (DLList_node, next),
+		offsetof (DLList_node, data)
+	};
+	void *tail = NULL;
+	DLList_node *node = NULL;
+	DLList_node *prev = NULL;
+
+	/***** if the list has one or less nodes its already sorted *****/
+
+	if (list->length < 2)
+		return;
+
+	list->head = LLSort_adaptive (&layout, list->head, cmp_func, &tail);
+	list->tail = tail;
+
+	/***** fix the prev pointers *****/
+
+	for (prev = NULL, node = list->head; node; prev = node, node = node->next)
+		node->prev = prev;
+
+	return;
+}
+
+/*******************************************************************************
+	function to sort a double linked list with several threads
+
+	Arguments:
+				list		the linked list to sort
+				cmp_func	function to compare the data in 2 nodes
+				threads		the most threads to use, including the calling thread
+
+	returns:
+				nothing
+
+	Notes:
+				fewer threads are used so each gets at least
+				DLLIST_SORT_PARALLEL_MIN nodes
+				cmp_func is called from several threads at once
+
+*******************************************************************************/
+
+void DLList_sort_parallel (
+	DLList * list,
+	DLList_data_cmp_func cmp_func,
+	size_t threads)
+{
+	LLSort_layout layout = {
+		offsetof (DLList_node, next),
+		offsetof (DLList_node, data)
+	};
+	void *tail = NULL;
+	DLList_node *node = NULL;
+	DLList_node *prev = NULL;
+
+	/***** small lists arnt worth the threads *****/
+
+	if (threads > list->length / DLLIST_SORT_PARALLEL_MIN)
+		threads = list->length / DLLIST_SORT_PARALLEL_MIN;
+
+	if (threads < 2) {
+		DLList_sort_adaptive (list, cmp_func);
+		return;
+	}
+
+	list->head = LLSort_parallel (&layout, list->head, list->length, cmp_func,
+																threads, &tail);
+	list->tail = tail;
+
+	/***** fix the prev pointers *****/
+
+	for (prev = NULL, node = list->head; node; prev = node, node = node->next)
+		node->prev = prev;
+
+	return;
+}
+
+/*******************************************************************************
+	function to sort a double linked list in an array
+
+	Arguments:
+				list		the linked list to sort
+				cmp_func	function to compare the data in 2 nodes
+				relocate	non zero to move the data between the nodes instead of
+									moving the nodes
+
+	returns:
+				0 on success
+				1 if out of memory, the list is left as it was
+
+*******************************************************************************/
+
+int DLList_sort_array (
+	DLList * list,
+	DLList_data_cmp_func cmp_func,
+	int relocate)
+{
+	LLSort_layout layout = {
+		offsetof (DLList_node, next),
+		offsetof (DLList_node, data)
+	};
+	void *head = list->head;
+	void *tail = NULL;
+	DLList_node *node = NULL;
+	DLList_node *prev = NULL;
+
+	/***** if the list has one or less nodes its already sorted *****/
+
+	if (list->length < 2)
+		return 0;
+
+	if (LLSort_array (&layout, &head, list->length, cmp_func, relocate, &tail))
+		return 1;
+
+	list->head = head;
+	list->tail = tail;
+
+	/***** fix the prev pointers *****/
+
+	for (prev = NULL, node = list->head; node; prev = node, node = node->next)
+		node->prev = prev;
+
+	return 0;
+}
+
+/*******************************************************************************
+	function to sort a double linked list by an integer key with a radix sort
+
+	Arguments:
+				list		the linked list to sort
+				key_func	function to get the key of the data in a node
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void DLList_sort_radix (
+	DLList * list,
+	DLList_data_key_func key_func)
+{
+	LLSort_layout layout = {
+		offsetof (DLList_node, next),
+		offsetof (DLList_node, data)
+	};
+	void *tail = NULL;
+	DLList_node *node = NULL;
+	DLList_node *prev = NULL;
+
+	/***** if the list has one or less nodes its already sorted *****/
+
+	if (list->length < 2)
+		return;
+
+	list->head = LLSort_radix (&layout, list->head, key_func, &tail);
+	list->tail = tail;
+
+	/***** fix the prev pointers *****/
+
+	for (prev = NULL, node = list->head; node; prev = node, node = node->next)
+		node->prev = prev;
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to make a chain of new nodes holding the data in an array
+
+	Arguments:
+				list		the linked list the nodes are for
+				array		the data
+				count		the number of entries in the array
+				reverse		non zero to take the array from the end
+				tail		set to the last node of the chain
+
+	returns:
+				the first node of the chain
+				NULL on error, nothing is allocated
+
+	notes:
+				with a pool all the nodes come from one block, without one each
+				node is malloced so it can be freed on its own
+
+*******************************************************************************/
+
+static DLList_node *DLList_new_chain (
+	DLList * list,
+	void **array,
+	size_t count,
+	int reverse,
+	DLList_node **tail)
+{
+	DLList_node *result = NULL;
+	DLList_node *new = NULL;
+	DLList_node *prev = NULL;
+	char *block = NULL;
+	size_t i;
+
+	if (list->pool &&
+			!(block = LLPool_alloc_block (list->pool, sizeof (DLList_node), count)))
+		return NULL;
+
+	for (i = 0; i < count; i++) {
+		if (block)
+			new = (DLList_node *) (block + i * list->pool->nodesize);
+
+		/***** out of memory? free what we have *****/
+
+		else if (!(new = malloc (sizeof (DLList_node)))) {
+			for (; result; result = new) {
+				new = result->next;
+				free (result);
+			}
+
+			return NULL;
+		}
+
+		new->data = array[reverse ? count - 1 - i : i];
+		new->next = NULL;
+		new->prev = prev;
+
+		if (!prev)
+			result = new;
+		else
+			prev->next = new;
+		prev = new;
+	}
+
+	*tail = prev;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to add the data in an array to the tail of a double linked list
+
+	Arguments:
+				list	the linked list
+				array	the data you wish to store in the linked list
+				count	the number of entries in the array
+
+	returns:
+				0 on success
+				1 on error, nothing is added
+
+	notes:
+				array[0] ends up nearest the head, as if each was appended in turn
+
+*******************************************************************************/
+
+int DLList_append_array (
+	DLList * list,
+	void **array,
+	size_t count)
+{
+	DLList_node *head = NULL;
+	DLList_node *tail = NULL;
+
+	if (!count)
+		return 0;
+
+	if (!(head = DLList_new_chain (list, array, count, 0, &tail)))
+		return 1;
+
+	/***** empty list? *****/
+
+	if (!list->head)
+		list->head = head;
+	else {
+		list->tail->next = head;
+		head->prev = list->tail;
+	}
+
+	list->tail = tail;
+	list->length += count;
+
+	return 0;
+}
+
+/*******************************************************************************
+	function to add the data in an array to the head of a double linked list
+
+	Arguments:
+				list	the linked list
+				array	the data you wish to store in the linked list
+				count	the number of entries in the array
+
+	returns:
+				0 on success
+				1 on error, nothing is added
+
+	notes:
+				array[count - 1] ends up at the head, as if each was prepended in
+				turn
+
+*******************************************************************************/
+
+int DLList_prepend_array (
+	DLList * list,
+	void **array,
+	size_t count)
+{
+	DLList_node *head = NULL;
+	DLList_node *tail = NULL;
+
+	if (!count)
+		return 0;
+
+	if (!(head = DLList_new_chain (list, array, count, 1, &tail)))
+		return 1;
+
+	/***** empty list? *****/
+
+	if (!list->head)
+		list->tail = tail;
+	else {
+		tail->next = list->head;
+		list->head->prev = tail;
+	}
+
+	list->head = head;
+	list->length += count;
+
+	return 0;
+}
+
+/*******************************************************************************
+	function to copy the data in a double linked list to an array
+
+	Arguments:
+				list	the linked list
+				array	the array to fill, it must have room for the length of the
+							list
+
+	returns:
+				the number of entries filled in
+
+	notes:
+				the array is filled from the head to the tail
+
+*******************************************************************************/
+
+size_t DLList_to_array (
+	DLList * list,
+	void **array)
+{
+	DLList_node *node = list->head;
+	size_t i;
+
+	for (i = 0; i < list->length; i++, node = node->next)
+		array[i] = node->data;
+
+	return i;
+}
+
+/*******************************************************************************
+	function to move the nodes of a double linked list next to each other in
+	the order they are linked
+
+	Arguments:
+				list		the linked list
+				function	function to call for each node moved, or NULL
+				extra		extra data to pass to the function
+
+	returns:
+				0 on success
+				1 on error, the list is left as it was
+
+	notes:
+				all the new nodes are allocated before any old node is freed so
+				malloc cant hand the old ones back out in the middle of the run
+
+*******************************************************************************/
+
+int DLList_compact (
+	DLList * list,
+	DLList_node_move_func function,
+	void *extra)
+{
+	DLList_node *node = NULL;
+	DLList_node *next = NULL;
+	DLList_node *new = NULL;
+	DLList_node *head = NULL;
+	DLList_node *prev = NULL;
+	char *block = NULL;
+	size_t i;
+
+	if (!list->length)
+		return 0;
+
+	if (list->pool &&
+			!(block = LLPool_alloc_block (list->pool, sizeof (DLList_node),
+																		list->length)))
+		return 1;
+
+	/***** build the new chain *****/
+
+	for (i = 0, node = list->head; node; i++, node = node->next) {
+		if (block)
+			new = (DLList_node *) (block + i * list->pool->nodesize);
+
+		/***** out of memory? free what we have *****/
+
+		else if (!(new = malloc (sizeof (DLList_node)))) {
+			for (; head; head = new) {
+				new = head->next;
+				free (head);
+			}
+
+			return 1;
+		}
+
+		new->data = node->data;
+		new->next = NULL;
+		new->prev = prev;
+
+		if (!prev)
+			head = new;
+		else
+			prev->next = new;
+		prev = new;
+	}
+
+	/***** tell the caller and free the old nodes *****/
+
+	for (node = list->head, new = head; node; node = next, new = new->next) {
+		next = node->next;
+
+		if (function)
+			function (list, node, new, extra);
+
+		LLPool_free (list->pool, node);
+	}
+
+	list->head = head;
+	list->tail = prev;
+
+	return 0;
+}
+
+/*******************************************************************************
+	slave function to undo the copies made by DLList_copy_list ()
+
+	returns:
+				nothing
+*******************************************************************************/
+
+static void DLList_copy_undo (
+	void **array,
+	size_t count,
+	DLList_data_free_func free_func,
+	LLArena * arena,
+	LLArena_mark * mark)
+{
+	size_t i;
+
+	if (free_func) {
+		for (i = 0; i < count; i++)
+			free_func (array[i]);
+	}
+
+	if (arena)
+		LLArena_release (arena, mark);
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to copy another list to the head or tail of a double linked list,
+	all or nothing
+
+	Arguments:
+				dest		the linked list you want to copy the src to
+				src			the linked list you want to copy to the dest
+				prepend		non zero to copy to the head
+				copy_func	function to copy the data held in each node
+				free_func	function to free the copies made if a later one fails,
+										or NULL
+				arena		the arena to pass to copy_func, or NULL
+
+	returns:
+				0 on success
+				1 on error, nothing is added
+
+	notes:
+				the src is walked length nodes from its head so a circular list
+				can be copied without breaking its circle
+				for the head the array is filled backwards, DLList_prepend_array ()
+				puts the last entry at the head, so the copies made before a
+				failed one are at the end of it
+				the nodes are only one block when dest->pool is set, a list
+				without a pool frees each node on its own
+
+*******************************************************************************/
+
+static int DLList_copy_list (
+	DLList * dest,
+	DLList * src,
+	int prepend,
+	DLList_data_arena_copy_func copy_func,
+	DLList_data_free_func free_func,
+	LLArena * arena)
+{
+	LLArena_mark mark = { NULL, 0 };
+	DLList_node *node = src->head;
+	size_t count = src->length;
+	void **array = NULL;
+	void *newdata;
+	size_t i;
+	int result = 0;
+
+	if (!count)
+		return 0;
+
+	if (!(array = malloc (count * sizeof (void *))))
+		return 1;
+
+	if (arena)
+		LLArena_save (arena, &mark);
+
+	/***** copy all the data first *****/
+
+	for (i = 0; i < count; i++, node = node->next) {
+		if (!copy_func (&newdata, node->data, arena)) {
+			DLList_copy_undo (array + (prepend ? count - i : 0), i, free_func,
+										 arena, &mark);
+			free (array);
+
+			return 1;
+		}
+
+		array[prepend ? count - 1 - i : i] = newdata;
+	}
+
+	/***** then add the nodes at once *****/
+
+	if (prepend)
+		result = DLList_prepend_array (dest, array, count);
+	else
+		result = DLList_append_array (dest, array, count);
+
+	if (result)
+		DLList_copy_undo (array, count, free_func, arena, &mark);
+
+	free (array);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to copy another list to the tail of a double linked list, all or
+	nothing
+
+	Arguments:
+				dest		the linked list you want to copy the src to
+				src			the linked list you want to copy to the dest
+				copy_func	function to copy the data held in each node
+				free_func	function to free the copies made if a later one fails,
+										or NULL
+				arena		the arena to pass to copy_func, or NULL
+
+	returns:
+				0 on success
+				1 on error, nothing is added
+
+*******************************************************************************/
+
+int DLList_append_list_copy_arena (
+	DLList * dest,
+	DLList * src,
+	DLList_data_arena_copy_func copy_func,
+	DLList_data_free_func free_func,
+	LLArena * arena)
+{
+	int result;
+
+	result = DLList_copy_list (dest, src, 0, copy_func, free_func, arena);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to copy another list to the head of a double linked list, all or
+	nothing
+
+	Arguments:
+				dest		the linked list you want to copy the src to
+				src			the linked list you want to copy to the dest
+				copy_func	function to copy the data held in each node
+				free_func	function to free the copies made if a later one fails,
+										or NULL
+				arena		the arena to pass to copy_func, or NULL
+
+	returns:
+				0 on success
+				1 on error, nothing is added
+
+*******************************************************************************/
+
+int DLList_prepend_list_copy_arena (
+	DLList * dest,
+	DLList * src,
+	DLList_data_arena_copy_func copy_func,
+	DLList_data_free_func free_func,
+	LLArena * arena)
+{
+	int result;
+
+	result = DLList_copy_list (dest, src, 1, copy_func, free_func, arena);
+
+	return result;
+}
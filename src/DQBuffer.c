@@ -0,0 +1,322 @@
+/*******************************************************************************
+	DQBuffer.c
+
+	deque in a ring buffer
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "../include/DQBuffer.h"
+
+/***** the slot of the item at a position, 0 is the head *****/
+
+#define SLOT(list, i) ((list)->buffer[((list)->first + (i)) & ((list)->size - 1)])
+
+/*******************************************************************************
+	slave function to make room for more items, doubling the buffer until
+	they fit
+
+	returns:
+				0 on success
+				1 on error
+*******************************************************************************/
+
+static int DQBuffer_grow (
+	DQBuffer *list,
+	size_t more)
+{
+	void **buffer = NULL;
+	size_t size = list->size ? list->size : DQBUFFER_SIZE;
+	size_t wrapped;
+
+	/***** too big to round up to a power of 2 and allocate *****/
+
+	if (more > SIZE_MAX / sizeof (void *) / 2 + 1 - list->length)
+		return 1;
+
+	while (size < list->length + more)
+		size <<= 1;
+
+	if (size == list->size)
+		return 0;
+
+	if (!(buffer = realloc (list->buffer, size * sizeof (void *))))
+		return 1;
+
+	/***** items that wrapped past the old end go after it *****/
+
+	if (list->first + list->length > list->size) {
+		wrapped = list->first + list->length - list->size;
+		memcpy (buffer + list->size, buffer, wrapped * sizeof (void *));
+	}
+
+	list->buffer = buffer;
+	list->size = size;
+
+	return 0;
+}
+
+/*******************************************************************************
+	function to push data onto the head of a deque
+
+	Arguments:
+				list	the deque
+				data	the data you wish to store in the deque
+
+	returns:
+				the data
+				NULL on error
+
+*******************************************************************************/
+
+void *DQBuffer_push (
+	DQBuffer * list,
+	void *data)
+{
+
+	if (list->length == list->size && DQBuffer_grow (list, 1))
+		return NULL;
+
+	list->first = (list->first - 1) & (list->size - 1);
+	list->buffer[list->first] = data;
+	list->length++;
+
+	return data;
+}
+
+/*******************************************************************************
+	function to pull data from the tail of a deque
+
+	Arguments:
+				list	the deque
+
+	returns:
+				the data
+				NULL if the deque is empty
+
+*******************************************************************************/
+
+void *DQBuffer_pull (
+	DQBuffer * list)
+{
+	void *result = NULL;
+
+	if (list->length) {
+		list->length--;
+		result = SLOT (list, list->length);
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to pop data from the head of a deque
+
+	Arguments:
+				list	the deque
+
+	returns:
+				the data
+				NULL if the deque is empty
+
+*******************************************************************************/
+
+void *DQBuffer_pop (
+	DQBuffer * list)
+{
+	void *result = NULL;
+
+	if (list->length) {
+		result = list->buffer[list->first];
+		list->first = (list->first + 1) & (list->size - 1);
+		list->length--;
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to read the tail of a deque without pulling it
+
+	Arguments:
+				list	the deque
+
+	returns:
+				the data
+				NULL if the deque is empty
+
+*******************************************************************************/
+
+void *DQBuffer_read_tail (
+	DQBuffer * list)
+{
+	void *result = NULL;
+
+	if (list->length)
+		result = SLOT (list, list->length - 1);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to read the head of a deque without popping it
+
+	Arguments:
+				list	the deque
+
+	returns:
+				the data
+				NULL if the deque is empty
+
+*******************************************************************************/
+
+void *DQBuffer_read_head (
+	DQBuffer * list)
+{
+	void *result = NULL;
+
+	if (list->length)
+		result = list->buffer[list->first];
+
+	return result;
+}
+
+/*******************************************************************************
+	function to count the items in a deque
+
+	Arguments:
+				list	the deque
+
+	returns:
+				the number of items in the deque
+
+*******************************************************************************/
+
+size_t DQBuffer_length (
+	DQBuffer * list)
+{
+	size_t result = list->length;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to iterate a deque from the head to the tail
+
+	Arguments:
+				list 		the deque
+				function	the function to pass each item to for processing
+				extra		extra data to pass to/from the proccessing function
+
+	returns:
+				the non null returned from the proccessing function that stops the
+				iteration
+				NULL if the end of the deque was reached
+
+*******************************************************************************/
+
+void *DQBuffer_iterate (
+	DQBuffer * list,
+	DQBuffer_iterate_func function,
+	void *extra)
+{
+	void *result = NULL;
+	size_t i;
+
+	for (i = 0; i < list->length && !result; i++)
+		result = function (list, i, SLOT (list, i), extra);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete all the items in a deque and free its buffer
+
+	Arguments:
+				list		the deque
+				function	the function to call to free the data, or NULL
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void DQBuffer_delete_all (
+	DQBuffer * list,
+	DQBuffer_data_free_func function)
+{
+	size_t i;
+
+	if (function) {
+		for (i = 0; i < list->length; i++)
+			function (SLOT (list, i));
+	}
+
+	free (list->buffer);
+
+	list->buffer = NULL;
+	list->length = 0;
+	list->size = 0;
+	list->first = 0;
+
+	return;
+}
+
+/*******************************************************************************
+	function to move another deque to the head of a deque
+
+	Arguments:
+				dest	the deque you want to move the src to
+				src		the deque you want to move to the dest
+
+	returns:
+				0 on success
+				1 on error, nothing is moved
+
+*******************************************************************************/
+
+int DQBuffer_push_list (
+	DQBuffer * dest,
+	DQBuffer * src)
+{
+	size_t i;
+
+	if (!src->length)
+		return 0;
+
+	if (dest->length + src->length > dest->size &&
+			DQBuffer_grow (dest, src->length))
+		return 1;
+
+	dest->first = (dest->first - src->length) & (dest->size - 1);
+	dest->length += src->length;
+
+	for (i = 0; i < src->length; i++)
+		SLOT (dest, i) = SLOT (src, i);
+
+	src->length = 0;
+	src->first = 0;
+
+	return 0;
+}
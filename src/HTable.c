@@ -0,0 +1,488 @@
+/*******************************************************************************
+	HTable.c
+
+	open addressing hash table
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "../include/HTable.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/***** control bytes, a full slot holds 7 bits of its hash *****/
+
+#define EMPTY 0x80
+#define DELETED 0xfe
+
+/***** the most slots that can be full, 7 in 8 *****/
+
+#define CAPACITY(size) ((size) - (size) / 8)
+
+/***** the 7 bits of the hash kept in the control byte *****/
+
+#define H2(hash) ((unsigned char) ((hash) >> (sizeof (size_t) * 8 - 7)))
+
+/*******************************************************************************
+	slave functions to find the slots in a group whose control byte matches,
+	bit i of the result is set for slot i
+
+	HTable_match		the control byte is byte
+	HTable_match_empty	the slot is empty
+	HTable_match_free	the slot is empty or deleted
+*******************************************************************************/
+
+#ifdef __SSE2__
+
+static unsigned HTable_match (
+	unsigned char *ctrl,
+	unsigned char byte)
+{
+	__m128i group = _mm_loadu_si128 ((__m128i *) ctrl);
+
+	return _mm_movemask_epi8 (_mm_cmpeq_epi8 (group, _mm_set1_epi8 (byte)));
+}
+
+static unsigned HTable_match_free (
+	unsigned char *ctrl)
+{
+
+	return _mm_movemask_epi8 (_mm_loadu_si128 ((__m128i *) ctrl));
+}
+
+#else
+
+static unsigned HTable_match (
+	unsigned char *ctrl,
+	unsigned char byte)
+{
+	unsigned result = 0;
+	int i;
+
+	for (i = 0; i < HTABLE_GROUP; i++)
+		result |= (unsigned) (ctrl[i] == byte) << i;
+
+	return result;
+}
+
+static unsigned HTable_match_free (
+	unsigned char *ctrl)
+{
+	unsigned result = 0;
+	int i;
+
+	for (i = 0; i < HTABLE_GROUP; i++)
+		result |= (unsigned) (ctrl[i] >> 7) << i;
+
+	return result;
+}
+
+#endif
+
+static unsigned HTable_match_empty (
+	unsigned char *ctrl)
+{
+
+	return HTable_match (ctrl, EMPTY);
+}
+
+/*******************************************************************************
+	slave function to hash data, the user's hash is mixed so the low bits
+	that pick the group and the high bits kept in the control byte both
+	depend on all of it
+
+	returns:
+				the hash
+*******************************************************************************/
+
+static size_t HTable_hash (
+	HTable *table,
+	void *data)
+{
+	size_t result = table->hash (data);
+
+	result *= (size_t) 0x9e3779b97f4a7c15ULL;
+	result ^= result >> (sizeof (size_t) * 4);
+
+	return result;
+}
+
+/*******************************************************************************
+	slave function to find the slot holding data
+
+	returns:
+				the slot
+				-1 if the data is not in the table
+*******************************************************************************/
+
+static long HTable_lookup (
+	HTable *table,
+	void *data,
+	size_t hash)
+{
+	size_t mask = table->size / HTABLE_GROUP - 1;
+	size_t group = hash & mask;
+	unsigned char h2 = H2 (hash);
+	unsigned char *ctrl = NULL;
+	unsigned match;
+	size_t probe;
+	size_t i;
+
+	if (!table->size)
+		return -1;
+
+	for (probe = 1; ; probe++) {
+		ctrl = table->ctrl + group * HTABLE_GROUP;
+
+		for (match = HTable_match (ctrl, h2); match; match &= match - 1) {
+			i = group * HTABLE_GROUP + __builtin_ctz (match);
+
+			if (!table->cmp (table->slot[i], data))
+				return i;
+		}
+
+		/***** an empty slot ends every probe that passes this group *****/
+
+		if (HTable_match_empty (ctrl))
+			return -1;
+
+		group = (group + probe) & mask;
+	}
+}
+
+/*******************************************************************************
+	slave function to find the first empty or deleted slot on the probe of a
+	hash
+
+	returns:
+				the slot
+*******************************************************************************/
+
+static size_t HTable_free_slot (
+	HTable *table,
+	size_t hash)
+{
+	size_t mask = table->size / HTABLE_GROUP - 1;
+	size_t group = hash & mask;
+	unsigned match;
+	size_t probe;
+
+	for (probe = 1;
+			 !(match = HTable_match_free (table->ctrl + group * HTABLE_GROUP));
+			 probe++)
+		group = (group + probe) & mask;
+
+	return group * HTABLE_GROUP + __builtin_ctz (match);
+}
+
+/*******************************************************************************
+	function to find data in a hash table
+
+	Arguments:
+				table	the table
+				data	data equal to the data to find
+
+	returns:
+				the data in the table
+				NULL if it is not in the table
+
+*******************************************************************************/
+
+void *HTable_find (
+	HTable * table,
+	void *data)
+{
+	void *result = NULL;
+	long i;
+
+	if ((i = HTable_lookup (table, data, HTable_hash (table, data))) >= 0)
+		result = table->slot[i];
+
+	return result;
+}
+
+/*******************************************************************************
+	function to insert data in a hash table
+
+	Arguments:
+				table	the table
+				data	the data to insert
+
+	returns:
+				the data in the table, if equal data was already there it is
+				returned and data is not inserted
+				NULL on error
+
+*******************************************************************************/
+
+void *HTable_insert (
+	HTable * table,
+	void *data)
+{
+	size_t hash = HTable_hash (table, data);
+	size_t i;
+	long found;
+
+	if ((found = HTable_lookup (table, data, hash)) >= 0)
+		return table->slot[found];
+
+	/***** out of empty slots? grow, or just clear the deleted marks *****/
+
+	if (!table->left && HTable_rehash (table, table->length * 2 + 1))
+		return NULL;
+
+	i = HTable_free_slot (table, hash);
+
+	if (table->ctrl[i] == EMPTY)
+		table->left--;
+
+	table->ctrl[i] = H2 (hash);
+	table->slot[i] = data;
+	table->length++;
+
+	return data;
+}
+
+/*******************************************************************************
+	function to delete data from a hash table
+
+	Arguments:
+				table	the table
+				data	data equal to the data to delete
+
+	returns:
+				the data that was in the table, it is not passed to table->free
+				NULL if it is not in the table
+
+	notes:
+				if the group still has an empty slot no probe ever went past it,
+				so the slot can be empty again, otherwise it is marked deleted so
+				probes keep going
+
+*******************************************************************************/
+
+void *HTable_delete (
+	HTable * table,
+	void *data)
+{
+	void *result = NULL;
+	long i;
+
+	if ((i = HTable_lookup (table, data, HTable_hash (table, data))) < 0)
+		return NULL;
+
+	result = table->slot[i];
+
+	if (HTable_match_empty (table->ctrl + i / HTABLE_GROUP * HTABLE_GROUP)) {
+		table->ctrl[i] = EMPTY;
+		table->left++;
+	}
+
+	else
+		table->ctrl[i] = DELETED;
+
+	table->length--;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to count the data in a hash table
+
+	Arguments:
+				table	the table
+
+	returns:
+				the number of data in the table
+
+*******************************************************************************/
+
+size_t HTable_length (
+	HTable * table)
+{
+	size_t result = table->length;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to make room in a hash table so it can hold a number of data
+	without rehashing
+
+	Arguments:
+				table	the table
+				count	the number of data the table must hold
+
+	returns:
+				0 on success
+				1 on error, the table is left as it was
+
+*******************************************************************************/
+
+int HTable_reserve (
+	HTable * table,
+	size_t count)
+{
+	int result = 0;
+
+	if (count > table->length + table->left)
+		result = HTable_rehash (table, count);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to rebuild a hash table with room for a number of data, dropping
+	the marks deleted data left behind
+
+	Arguments:
+				table	the table
+				count	the number of data the table must hold, less than the
+							length is taken as the length
+
+	returns:
+				0 on success
+				1 on error, the table is left as it was
+
+	notes:
+				the slots and the control bytes are one allocation
+
+*******************************************************************************/
+
+int HTable_rehash (
+	HTable * table,
+	size_t count)
+{
+	size_t size = HTABLE_GROUP;
+	void **slot = NULL;
+	unsigned char *ctrl = NULL;
+	HTable new;
+	size_t hash;
+	size_t i;
+	size_t j;
+
+	if (count < table->length)
+		count = table->length;
+
+	/***** too big to round up to a power of 2 and allocate *****/
+
+	if (count > SIZE_MAX / (sizeof (void *) + 1) / 4)
+		return 1;
+
+	while (CAPACITY (size) < count)
+		size <<= 1;
+
+	if (!(slot = malloc (size * (sizeof (void *) + 1))))
+		return 1;
+
+	ctrl = (unsigned char *) (slot + size);
+	memset (ctrl, EMPTY, size);
+
+	new = *table;
+	new.size = size;
+	new.slot = slot;
+	new.ctrl = ctrl;
+	new.left = CAPACITY (size) - table->length;
+
+	for (i = 0; i < table->size; i++) {
+		if (!(table->ctrl[i] & EMPTY)) {
+			hash = HTable_hash (table, table->slot[i]);
+			j = HTable_free_slot (&new, hash);
+			ctrl[j] = H2 (hash);
+			slot[j] = table->slot[i];
+		}
+	}
+
+	free (table->slot);
+	*table = new;
+
+	return 0;
+}
+
+/*******************************************************************************
+	function to iterate a hash table
+
+	Arguments:
+				table 		the table
+				function	the function to pass each data to for processing
+				extra		extra data to pass to/from the proccessing function
+
+	returns:
+				the non null returned from the proccessing function that stops the
+				iteration
+				NULL if the end of the table was reached
+
+*******************************************************************************/
+
+void *HTable_iterate (
+	HTable * table,
+	HTable_iterate_func function,
+	void *extra)
+{
+	void *result = NULL;
+	size_t i;
+
+	for (i = 0; i < table->size && !result; i++) {
+		if (!(table->ctrl[i] & EMPTY))
+			result = function (table, table->slot[i], extra);
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete all the data in a hash table and free its slots
+
+	Arguments:
+				table	the table
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void HTable_delete_all (
+	HTable * table)
+{
+	size_t i;
+
+	if (table->free) {
+		for (i = 0; i < table->size; i++) {
+			if (!(table->ctrl[i] & EMPTY))
+				table->free (table->slot[i]);
+		}
+	}
+
+	free (table->slot);
+
+	table->slot = NULL;
+	table->ctrl = NULL;
+	table->size = 0;
+	table->left = 0;
+	table->length = 0;
+
+	return;
+}
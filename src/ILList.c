@@ -0,0 +1,472 @@
+/*******************************************************************************
+	ILList.c
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include "../include/ILList.h"
+
+/*******************************************************************************
+	function to add a link to the head of an intrusive linked list
+
+	Arguments:
+				list	the linked list
+				link	the link to add
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void ILList_prepend (
+	ILList *list,
+	ILList_link *link)
+{
+
+	link->prev = NULL;
+	link->next = list->head;
+
+	/***** empty list? *****/
+
+	if (!list->head)
+		list->tail = link;
+	else
+		list->head->prev = link;
+
+	list->head = link;
+	list->length++;
+
+	return;
+}
+
+/*******************************************************************************
+	function to add a link to the tail of an intrusive linked list
+
+	Arguments:
+				list	the linked list
+				link	the link to add
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void ILList_append (
+	ILList *list,
+	ILList_link *link)
+{
+
+	link->next = NULL;
+	link->prev = list->tail;
+
+	/***** empty list? *****/
+
+	if (!list->tail)
+		list->head = link;
+	else
+		list->tail->next = link;
+
+	list->tail = link;
+	list->length++;
+
+	return;
+}
+
+/*******************************************************************************
+	function to add a link after any link in an intrusive linked list
+
+	Arguments:
+				list	the linked list
+				node	the link you wish to place the new link after
+				link	the link to add
+
+	returns:
+				nothing
+
+  note:
+        if node is null the link will be appended to the list
+*******************************************************************************/
+
+void ILList_insert_after (
+	ILList *list,
+	ILList_link *node,
+	ILList_link *link)
+{
+
+	/***** last entry or node is null *****/
+
+	if (!node || node == list->tail)
+		ILList_append (list, link);
+
+	/***** middle entry *****/
+
+	else {
+		link->prev = node;
+		link->next = node->next;
+		node->next->prev = link;
+		node->next = link;
+		list->length++;
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	function to add a link before any link in an intrusive linked list
+
+	Arguments:
+				list	the linked list
+				node	the link you wish to place the new link before
+				link	the link to add
+
+	returns:
+				nothing
+
+  note:
+        if node is null the link will be prepended to the list
+*******************************************************************************/
+
+void ILList_insert_before (
+	ILList *list,
+	ILList_link *node,
+	ILList_link *link)
+{
+
+	/***** first entry or node is null *****/
+
+	if (!node || node == list->head)
+		ILList_prepend (list, link);
+
+	/***** middle entry *****/
+
+	else {
+		link->next = node;
+		link->prev = node->prev;
+		node->prev->next = link;
+		node->prev = link;
+		list->length++;
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	function to remove a link from an intrusive linked list
+
+	Arguments:
+				list	the linked list
+				link	the link to remove
+
+	returns:
+				the link
+
+*******************************************************************************/
+
+ILList_link *ILList_delete (
+	ILList *list,
+	ILList_link *link)
+{
+
+	if (link->prev)
+		link->prev->next = link->next;
+	else
+		list->head = link->next;
+
+	if (link->next)
+		link->next->prev = link->prev;
+	else
+		list->tail = link->prev;
+
+	link->prev = NULL;
+	link->next = NULL;
+	list->length--;
+
+	return link;
+}
+
+/*******************************************************************************
+	function to count the links in an intrusive linked list
+
+	Arguments:
+				list	the linked list
+
+	returns:
+				the number of links in the linked list
+
+*******************************************************************************/
+
+size_t ILList_length (
+	ILList *list)
+{
+	size_t result = list->length;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to iterate an intrusive linked list
+
+	Arguments:
+				list 		the linked list
+				function	the function to pass each link to for processing
+				extra		extra data to pass to/from the proccessing function
+
+	return:
+			the non null returned from the proccessing function that stops the
+			iteration
+			NULL if the end of the linked list was reached
+
+*******************************************************************************/
+
+void *ILList_iterate (
+	ILList *list,
+	ILList_iterate_func function,
+	void *extra)
+{
+	ILList_link *link = NULL;
+	ILList_link *next = NULL;
+	void *result = NULL;
+
+	for (link = list->head; link && !result; link = next) {
+		next = link->next;
+		result = function (list, link, extra);
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to remove all the links in an intrusive linked list
+
+	Arguments:
+				list		the linked list
+				function	the function to call to free the structure each link is
+									embedded in, or NULL
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void ILList_delete_all (
+	ILList *list,
+	ILList_link_free_func function)
+{
+	ILList_link *link = NULL;
+	ILList_link *next = NULL;
+
+	for (link = list->head; link; link = next) {
+		next = link->next;
+		link->prev = NULL;
+		link->next = NULL;
+
+		if (function)
+			function (link);
+	}
+
+	list->head = NULL;
+	list->tail = NULL;
+	list->length = 0;
+
+	return;
+}
+
+/*******************************************************************************
+	function to move another intrusive linked list to the head of an intrusive
+	linked list
+
+	Arguments:
+				dest	the linked list you want to move the src to
+				src		the linked list you want to move to the dest
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void ILList_prepend_list (
+	ILList *dest,
+	ILList *src)
+{
+
+	/***** is src an empty list *****/
+
+	if (!src->head) {
+	}
+
+	/***** is dest an empty list *****/
+
+	else if (!dest->head) {
+		dest->head = src->head;
+		dest->tail = src->tail;
+	}
+
+	else {
+		dest->head->prev = src->tail;
+		src->tail->next = dest->head;
+		dest->head = src->head;
+	}
+
+	dest->length += src->length;
+	src->head = NULL;
+	src->tail = NULL;
+	src->length = 0;
+
+	return;
+}
+
+/*******************************************************************************
+	function to move another intrusive linked list to the tail of an intrusive
+	linked list
+
+	Arguments:
+				dest	the linked list you want to move the src to
+				src		the linked list you want to move to the dest
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void ILList_append_list (
+	ILList *dest,
+	ILList *src)
+{
+
+	/***** is src an empty list *****/
+
+	if (!src->head) {
+	}
+
+	/***** is dest an empty list *****/
+
+	else if (!dest->head) {
+		dest->head = src->head;
+		dest->tail = src->tail;
+	}
+
+	else {
+		dest->tail->next = src->head;
+		src->head->prev = dest->tail;
+		dest->tail = src->tail;
+	}
+
+	dest->length += src->length;
+	src->head = NULL;
+	src->tail = NULL;
+	src->length = 0;
+
+	return;
+}
+
+/*******************************************************************************
+	function to move another intrusive linked list to the middle of an
+	intrusive linked list, after a particular link
+
+	Arguments:
+				dest	the linked list you want to move the src to
+				src		the linked list you want to move to the dest
+				node	the link you wish to insert src after
+
+	returns:
+				nothing
+
+	if node is null src is appended to dest
+
+*******************************************************************************/
+
+void ILList_insert_list_after (
+	ILList *dest,
+	ILList *src,
+	ILList_link *node)
+{
+
+	/***** is node null or tail? then append *****/
+
+	if (!node || node == dest->tail)
+		ILList_append_list (dest, src);
+
+	/***** is src an empty list *****/
+
+	else if (!src->head) {
+	}
+
+	else {
+		src->tail->next = node->next;
+		node->next->prev = src->tail;
+		node->next = src->head;
+		src->head->prev = node;
+
+		dest->length += src->length;
+		src->head = NULL;
+		src->tail = NULL;
+		src->length = 0;
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	function to move another intrusive linked list to the middle of an
+	intrusive linked list, before a particular link
+
+	Arguments:
+				dest	the linked list you want to move the src to
+				src		the linked list you want to move to the dest
+				node	the link you wish to insert src before
+
+	returns:
+				nothing
+
+	if node is null src is prepended to dest
+
+*******************************************************************************/
+
+void ILList_insert_list_before (
+	ILList *dest,
+	ILList *src,
+	ILList_link *node)
+{
+
+	/***** is node null or head? then prepend *****/
+
+	if (!node || node == dest->head)
+		ILList_prepend_list (dest, src);
+
+	/***** is src an empty list *****/
+
+	else if (!src->head) {
+	}
+
+	else {
+		node->prev->next = src->head;
+		src->head->prev = node->prev;
+		node->prev = src->tail;
+		src->tail->next = node;
+
+		dest->length += src->length;
+		src->head = NULL;
+		src->tail = NULL;
+		src->length = 0;
+	}
+
+	return;
+}
@@ -0,0 +1,532 @@
+/*******************************************************************************
+	LFList.c
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "../include/LFList.h"
+
+/***** the deleted mark lives in the low bit of the next pointer *****/
+
+#define MARKED(p) ((size_t) (p) & 1)
+#define MARK(p) ((LFList_node *) ((size_t) (p) | 1))
+#define UNMARK(p) ((LFList_node *) ((size_t) (p) & ~(size_t) 1))
+
+#define CAS(ptr, old, new) __sync_bool_compare_and_swap (ptr, old, new)
+#define BARRIER() __sync_synchronize ()
+
+/*******************************************************************************
+	slave function to free a chain of retired nodes, returns how many it freed
+*******************************************************************************/
+
+static size_t LFList_free_chain (
+	LFList *list,
+	LFList_node *node)
+{
+	LFList_node *next = NULL;
+	size_t result = 0;
+
+	for (; node; node = next, result++) {
+		next = node->retired;
+
+		if (list->free)
+			list->free (node->data);
+
+		free (node);
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	slave function to free the nodes a thread retired 2 or more epochs ago
+*******************************************************************************/
+
+static void LFList_reclaim (
+	LFList *list,
+	LFList_thread *thread,
+	unsigned long epoch)
+{
+	int i;
+
+	for (i = 0; i < 3; i++) {
+		if (thread->retired[i] && thread->tag[i] + 2 <= epoch) {
+			thread->pending -= LFList_free_chain (list, thread->retired[i]);
+			thread->retired[i] = NULL;
+		}
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to move the epoch on if every thread inside a list function
+	has seen it
+*******************************************************************************/
+
+static void LFList_advance (
+	LFList *list)
+{
+	LFList_thread *t = NULL;
+	unsigned long epoch = list->epoch;
+
+	BARRIER ();
+
+	for (t = list->threads; t; t = t->next) {
+		if (t->active && t->epoch != epoch)
+			return;
+	}
+
+	CAS (&list->epoch, epoch, epoch + 1);
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to mark a thread as inside a list function
+*******************************************************************************/
+
+static void LFList_enter (
+	LFList *list,
+	LFList_thread *thread)
+{
+	unsigned long epoch;
+
+	thread->active = 1;
+	BARRIER ();
+
+	epoch = list->epoch;
+
+	if (thread->epoch != epoch) {
+		thread->epoch = epoch;
+		LFList_reclaim (list, thread, epoch);
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to mark a thread as outside the list functions
+*******************************************************************************/
+
+static void LFList_leave (
+	LFList *list,
+	LFList_thread *thread)
+{
+
+	(void) list;
+
+	BARRIER ();
+	thread->active = 0;
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to queue an unlinked node to be freed
+
+	notes:
+				the node is tagged with the global epoch read after it was
+				unlinked, any thread that can still see it came in at that epoch
+				or before, so it is safe to free once the epoch is 2 on
+*******************************************************************************/
+
+static void LFList_retire (
+	LFList *list,
+	LFList_thread *thread,
+	LFList_node *node)
+{
+	unsigned long epoch = list->epoch;
+	int i = epoch % 3;
+
+	/***** anything left in the slot is from 3 or more epochs ago *****/
+
+	if (thread->retired[i] && thread->tag[i] != epoch) {
+		thread->pending -= LFList_free_chain (list, thread->retired[i]);
+		thread->retired[i] = NULL;
+	}
+
+	node->retired = thread->retired[i];
+	thread->retired[i] = node;
+	thread->tag[i] = epoch;
+
+	if (++thread->pending >= LFLIST_RETIRE_SCAN) {
+		LFList_advance (list);
+		LFList_reclaim (list, thread, list->epoch);
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to find where data goes in the list, unlinking any deleted
+	nodes on the way
+
+	Arguments:
+				list		the linked list
+				thread	the calling thread's record
+				data		the data to look for
+				prev		set to the link that points at cur
+				cur			set to the first node not less than data, or NULL
+
+	returns:
+				non zero if cur holds data equal to data
+*******************************************************************************/
+
+static int LFList_search (
+	LFList *list,
+	LFList_thread *thread,
+	void *data,
+	LFList_node *volatile **prev,
+	LFList_node **cur)
+{
+	LFList_node *volatile *p = NULL;
+	LFList_node *c = NULL;
+	LFList_node *next = NULL;
+	int cmp;
+
+retry:
+	p = &list->head;
+	c = *p;
+
+	while (c) {
+		next = c->next;
+
+		/***** c is deleted? unlink it *****/
+
+		if (MARKED (next)) {
+			if (!CAS (p, c, UNMARK (next)))
+				goto retry;
+
+			LFList_retire (list, thread, c);
+			c = UNMARK (next);
+			continue;
+		}
+
+		/***** the link we came through changed? start over *****/
+
+		if (*p != c)
+			goto retry;
+
+		if ((cmp = list->cmp (c->data, data)) >= 0) {
+			*prev = p;
+			*cur = c;
+			return !cmp;
+		}
+
+		p = &c->next;
+		c = next;
+	}
+
+	*prev = p;
+	*cur = NULL;
+
+	return 0;
+}
+
+/*******************************************************************************
+	function to get a thread record for the calling thread
+
+	Arguments:
+				list	the linked list
+
+	returns:
+				the thread record to pass to the other functions
+				NULL on error
+
+*******************************************************************************/
+
+LFList_thread *LFList_thread_get (
+	LFList * list)
+{
+	LFList_thread *result = NULL;
+	int i;
+
+	/***** reuse a released record? *****/
+
+	for (result = list->threads; result; result = result->next) {
+		if (!result->used && CAS (&result->used, 0, 1))
+			return result;
+	}
+
+	if (!(result = malloc (sizeof (LFList_thread))))
+		return NULL;
+
+	result->used = 1;
+	result->active = 0;
+	result->epoch = list->epoch;
+	result->pending = 0;
+
+	for (i = 0; i < 3; i++) {
+		result->retired[i] = NULL;
+		result->tag[i] = 0;
+	}
+
+	do {
+		result->next = list->threads;
+	} while (!CAS (&list->threads, result->next, result));
+
+	return result;
+}
+
+/*******************************************************************************
+	function to release a thread record
+
+	Arguments:
+				list	the linked list
+				thread	the thread record
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void LFList_thread_release (
+	LFList * list,
+	LFList_thread * thread)
+{
+
+	(void) list;
+
+	BARRIER ();
+	thread->active = 0;
+	thread->used = 0;
+
+	return;
+}
+
+/*******************************************************************************
+	function to find data in a lock free linked list
+
+	Arguments:
+				list	the linked list
+				thread	the calling thread's record
+				data	the data to look for
+
+	returns:
+				non zero if data equal to data is in the list
+				0 if not
+
+	notes:
+				a plain walk that does not help unlink deleted nodes
+
+*******************************************************************************/
+
+int LFList_find (
+	LFList * list,
+	LFList_thread * thread,
+	void *data)
+{
+	LFList_node *node = NULL;
+	int cmp = 1;
+
+	LFList_enter (list, thread);
+
+	for (node = list->head; node; node = UNMARK (node->next)) {
+		if ((cmp = list->cmp (node->data, data)) >= 0)
+			break;
+	}
+
+	/***** equal but deleted doesnt count *****/
+
+	if (node && !cmp && MARKED (node->next))
+		cmp = 1;
+
+	LFList_leave (list, thread);
+
+	return node && !cmp;
+}
+
+/*******************************************************************************
+	function to add data to a lock free linked list
+
+	Arguments:
+				list	the linked list
+				thread	the calling thread's record
+				data	the data you wish to store in the linked list
+
+	returns:
+				0 on success
+				1 if equal data is already in the list
+				-1 on error
+
+*******************************************************************************/
+
+int LFList_insert (
+	LFList * list,
+	LFList_thread * thread,
+	void *data)
+{
+	LFList_node *volatile *prev = NULL;
+	LFList_node *cur = NULL;
+	LFList_node *new = NULL;
+	int result = -1;
+
+	if (!(new = malloc (sizeof (LFList_node))))
+		return -1;
+
+	new->data = data;
+	new->retired = NULL;
+
+	LFList_enter (list, thread);
+
+	while (result < 0) {
+		if (LFList_search (list, thread, data, &prev, &cur))
+			result = 1;
+
+		else {
+			new->next = cur;
+
+			if (CAS (prev, cur, new)) {
+				__sync_fetch_and_add (&list->length, 1);
+				result = 0;
+			}
+		}
+	}
+
+	LFList_leave (list, thread);
+
+	if (result)
+		free (new);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete data from a lock free linked list
+
+	Arguments:
+				list	the linked list
+				thread	the calling thread's record
+				data	the data to delete
+
+	returns:
+				0 on success
+				1 if no equal data is in the list
+
+*******************************************************************************/
+
+int LFList_delete (
+	LFList * list,
+	LFList_thread * thread,
+	void *data)
+{
+	LFList_node *volatile *prev = NULL;
+	LFList_node *cur = NULL;
+	LFList_node *next = NULL;
+	int result = -1;
+
+	LFList_enter (list, thread);
+
+	while (result < 0) {
+		if (!LFList_search (list, thread, data, &prev, &cur))
+			result = 1;
+
+		else {
+			next = cur->next;
+
+			/***** mark it, the thread that marks it owns the delete *****/
+
+			if (MARKED (next) || !CAS (&cur->next, next, MARK (next)))
+				continue;
+
+			__sync_fetch_and_sub (&list->length, 1);
+			result = 0;
+
+			/***** unlink it, or let a search do it *****/
+
+			if (CAS (prev, cur, next))
+				LFList_retire (list, thread, cur);
+			else
+				LFList_search (list, thread, data, &prev, &cur);
+		}
+	}
+
+	LFList_leave (list, thread);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to count the nodes in a lock free linked list
+
+	Arguments:
+				list	the linked list
+
+	returns:
+				the number of nodes in the linked list
+
+*******************************************************************************/
+
+size_t LFList_length (
+	LFList * list)
+{
+	size_t result = list->length;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete all the nodes and thread records of a lock free linked
+	list
+
+	Arguments:
+				list	the linked list
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void LFList_delete_all (
+	LFList * list)
+{
+	LFList_node *node = NULL;
+	LFList_node *next = NULL;
+	LFList_thread *thread = NULL;
+	LFList_thread *tnext = NULL;
+	int i;
+
+	for (node = list->head; node; node = next) {
+		next = UNMARK (node->next);
+
+		if (list->free)
+			list->free (node->data);
+
+		free (node);
+	}
+
+	for (thread = list->threads; thread; thread = tnext) {
+		tnext = thread->next;
+
+		for (i = 0; i < 3; i++)
+			LFList_free_chain (list, thread->retired[i]);
+
+		free (thread);
+	}
+
+	list->head = NULL;
+	list->threads = NULL;
+	list->length = 0;
+
+	return;
+}
@@ -0,0 +1,368 @@
+/*******************************************************************************
+	LFQueue.c
+
+	lock free fifo
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "../include/LFQueue.h"
+#include "LLDword.h"
+
+/***** the node and tag are swapped as one double width word *****/
+
+LLDWORD_CHECK (LFQueue_ptr);
+
+/*******************************************************************************
+	slave function to swap a counted pointer if it has not changed
+*******************************************************************************/
+
+static int LLDWORD_TARGET LFQueue_cas (
+	LFQueue_ptr *ptr,
+	LFQueue_ptr *old,
+	LFQueue_node *node)
+{
+	LFQueue_ptr new;
+
+	new.node = node;
+	new.tag = old->tag + 1;
+
+	return __sync_bool_compare_and_swap ((volatile LLDword *) ptr,
+																			 *(LLDword *) old,
+																			 *(LLDword *) &new);
+}
+
+/*******************************************************************************
+	slave function to read a counted pointer, the tag first so a node read
+	with a newer tag fails the swap
+*******************************************************************************/
+
+static void LFQueue_read_ptr (
+	LFQueue_ptr *ptr,
+	LFQueue_ptr *old)
+{
+
+	old->tag = ptr->tag;
+	LLDWORD_ORDER ();
+	old->node = ptr->node;
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to see if a counted pointer still holds what was read
+*******************************************************************************/
+
+static int LFQueue_same (
+	LFQueue_ptr *ptr,
+	LFQueue_ptr *old)
+{
+
+	return ptr->tag == old->tag && ptr->node == old->node;
+}
+
+/*******************************************************************************
+	slave function to set a counted pointer, the tag always moves on so a
+	thread that read it before can not swap it
+*******************************************************************************/
+
+static void LFQueue_set (
+	LFQueue_ptr *ptr,
+	LFQueue_node *node)
+{
+	LFQueue_ptr old;
+
+	do {
+		LFQueue_read_ptr (ptr, &old);
+	} while (!LFQueue_cas (ptr, &old, node));
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to point the head and tail at the stub the first time the
+	que is used
+*******************************************************************************/
+
+static void LFQueue_start (
+	LFQueue *list)
+{
+	LFQueue_ptr old;
+
+	if (!list->head.node) {
+		LFQueue_read_ptr (&list->head, &old);
+
+		if (!old.node)
+			LFQueue_cas (&list->head, &old, &list->stub);
+	}
+
+	if (!list->tail.node) {
+		LFQueue_read_ptr (&list->tail, &old);
+
+		if (!old.node)
+			LFQueue_cas (&list->tail, &old, &list->stub);
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	function to push a node onto a lock free que
+
+	Arguments:
+				list	the que
+				data	the data you wish to store in the que
+
+	returns:
+				the new node
+				NULL on error
+
+	notes:
+				a node is reused from the spare stack before one is malloced
+
+*******************************************************************************/
+
+LFQueue_node *LFQueue_push (
+	LFQueue * list,
+	void *data)
+{
+	LFQueue_node *new = NULL;
+	LFQueue_ptr old;
+	LFQueue_ptr tail;
+	LFQueue_ptr next;
+
+	LFQueue_start (list);
+
+	/***** take a spare node *****/
+
+	do {
+		LFQueue_read_ptr (&list->spare, &old);
+
+		if (!old.node)
+			break;
+
+	} while (!LFQueue_cas (&list->spare, &old, old.node->next.node));
+
+	if (!(new = old.node)) {
+		if (!(new = malloc (sizeof (LFQueue_node))))
+			return NULL;
+
+		new->next.node = NULL;
+		new->next.tag = 0;
+	}
+
+	else
+		LFQueue_set (&new->next, NULL);
+
+	new->data = data;
+
+	/***** count it before it can be pulled so the count never wraps *****/
+
+	__sync_fetch_and_add (&list->length, 1);
+
+	/***** link it after the last node *****/
+
+	while (1) {
+		LFQueue_read_ptr (&list->tail, &tail);
+		LFQueue_read_ptr (&tail.node->next, &next);
+
+		if (!LFQueue_same (&list->tail, &tail)) {
+		}
+
+		else if (next.node)
+			LFQueue_cas (&list->tail, &tail, next.node);
+
+		else if (LFQueue_cas (&tail.node->next, &next, new))
+			break;
+	}
+
+	/***** move the tail on, if another thread hasnt already *****/
+
+	LFQueue_cas (&list->tail, &tail, new);
+
+	return new;
+}
+
+/*******************************************************************************
+	function to pull a node from a lock free que
+
+	Arguments:
+				list	the que
+
+	returns:
+				the data the node held
+				NULL if the que is empty
+
+	notes:
+				the node after the head is read and the head moved onto it, the
+				old head goes to the spare stack and the pulled node becomes the
+				new dummy
+
+*******************************************************************************/
+
+void *LFQueue_pull (
+	LFQueue * list)
+{
+	LFQueue_ptr head;
+	LFQueue_ptr tail;
+	LFQueue_ptr next;
+	LFQueue_ptr old;
+	void *result = NULL;
+
+	LFQueue_start (list);
+
+	while (1) {
+		LFQueue_read_ptr (&list->head, &head);
+		LFQueue_read_ptr (&list->tail, &tail);
+		LFQueue_read_ptr (&head.node->next, &next);
+
+		if (!LFQueue_same (&list->head, &head)) {
+		}
+
+		/***** empty, or the tail is behind *****/
+
+		else if (head.node == tail.node) {
+			if (!next.node)
+				return NULL;
+
+			LFQueue_cas (&list->tail, &tail, next.node);
+		}
+
+		/***** read the data before another thread can reuse the node *****/
+
+		else {
+			result = next.node->data;
+
+			if (LFQueue_cas (&list->head, &head, next.node))
+				break;
+		}
+	}
+
+	__sync_fetch_and_sub (&list->length, 1);
+
+	/***** the old dummy goes on the spare stack *****/
+
+	do {
+		LFQueue_read_ptr (&list->spare, &old);
+		LFQueue_set (&head.node->next, old.node);
+	} while (!LFQueue_cas (&list->spare, &old, head.node));
+
+	return result;
+}
+
+/*******************************************************************************
+	function to read the data that will be pulled next without pulling it
+
+	Arguments:
+				list	the que
+
+	returns:
+				the data the node holds
+				NULL if the que is empty
+
+*******************************************************************************/
+
+void *LFQueue_read (
+	LFQueue * list)
+{
+	LFQueue_node *head = list->head.node;
+	LFQueue_node *next = NULL;
+	void *result = NULL;
+
+	if (head && (next = head->next.node))
+		result = next->data;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to count the nodes in a lock free que
+
+	Arguments:
+				list	the que
+
+	returns:
+				the number of nodes in the que
+
+	notes:
+				a node is counted before it is linked in and uncounted after it is
+				pulled, so while other threads push the count can be a little
+				high but never wraps below 0
+
+*******************************************************************************/
+
+size_t LFQueue_length (
+	LFQueue * list)
+{
+	size_t result = list->length;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete all the nodes in a lock free que
+
+	Arguments:
+				list		the que
+				function	the function to call to free the data, or NULL
+
+	returns:
+				nothing
+
+	notes:
+				the dummy at the head holds no data, the stub is part of the que
+				and is not freed
+
+*******************************************************************************/
+
+void LFQueue_delete_all (
+	LFQueue * list,
+	LFQueue_data_free_func function)
+{
+	LFQueue_node *node = NULL;
+	LFQueue_node *next = NULL;
+
+	for (node = list->head.node; node; node = next) {
+		next = node->next.node;
+
+		if (function && node != list->head.node)
+			function (node->data);
+
+		if (node != &list->stub)
+			free (node);
+	}
+
+	for (node = list->spare.node; node; node = next) {
+		next = node->next.node;
+
+		if (node != &list->stub)
+			free (node);
+	}
+
+	list->head.node = NULL;
+	list->tail.node = NULL;
+	list->spare.node = NULL;
+	list->stub.next.node = NULL;
+	list->length = 0;
+
+	return;
+}
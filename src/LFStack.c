@@ -0,0 +1,339 @@
+/*******************************************************************************
+	LFStack.c
+
+	lock free filo
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "../include/LFStack.h"
+#include "LLDword.h"
+
+/***** the node and tag are swapped as one double width word *****/
+
+LLDWORD_CHECK (LFStack_top);
+
+/*******************************************************************************
+	slave function to swap the top of a stack if it has not changed
+*******************************************************************************/
+
+static int LLDWORD_TARGET LFStack_cas (
+	LFStack_top *top,
+	LFStack_top *old,
+	LFStack_node *node)
+{
+	LFStack_top new;
+
+	new.node = node;
+	new.tag = old->tag + 1;
+
+	return __sync_bool_compare_and_swap ((volatile LLDword *) top,
+																			 *(LLDword *) old,
+																			 *(LLDword *) &new);
+}
+
+/*******************************************************************************
+	slave function to read the top of a stack, the tag first so a node read
+	with a newer tag fails the swap
+*******************************************************************************/
+
+static void LFStack_read (
+	LFStack_top *top,
+	LFStack_top *old)
+{
+
+	old->tag = top->tag;
+	LLDWORD_ORDER ();
+	old->node = top->node;
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to push a chain of nodes onto the top of a stack
+*******************************************************************************/
+
+static void LFStack_push_chain (
+	LFStack_top *top,
+	LFStack_node *first,
+	LFStack_node *last)
+{
+	LFStack_top old;
+
+	do {
+		LFStack_read (top, &old);
+		last->next = old.node;
+	} while (!LFStack_cas (top, &old, first));
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to pop the top node of a stack
+*******************************************************************************/
+
+static LFStack_node *LFStack_pop_node (
+	LFStack_top *top)
+{
+	LFStack_top old;
+
+	do {
+		LFStack_read (top, &old);
+
+		if (!old.node)
+			return NULL;
+
+	} while (!LFStack_cas (top, &old, old.node->next));
+
+	return old.node;
+}
+
+/*******************************************************************************
+	slave function to take every node of a stack
+*******************************************************************************/
+
+static LFStack_node *LFStack_take (
+	LFStack_top *top)
+{
+	LFStack_top old;
+
+	do {
+		LFStack_read (top, &old);
+
+		if (!old.node)
+			return NULL;
+
+	} while (!LFStack_cas (top, &old, NULL));
+
+	return old.node;
+}
+
+/*******************************************************************************
+	function to push a node onto a lock free stack
+
+	Arguments:
+				list	the stack
+				data	the data you wish to store in the stack
+
+	returns:
+				the new node
+				NULL on error
+
+	notes:
+				a node is reused from the spare stack before one is malloced
+
+*******************************************************************************/
+
+LFStack_node *LFStack_push (
+	LFStack * list,
+	void *data)
+{
+	LFStack_node *new = NULL;
+
+	if (!(new = LFStack_pop_node (&list->spare)) &&
+			!(new = malloc (sizeof (LFStack_node))))
+		return NULL;
+
+	new->data = data;
+
+	/***** count it before it can be popped so the count never wraps *****/
+
+	__sync_fetch_and_add (&list->length, 1);
+	LFStack_push_chain (&list->head, new, new);
+
+	return new;
+}
+
+/*******************************************************************************
+	function to pop a node from a lock free stack
+
+	Arguments:
+				list	the stack
+
+	returns:
+				the data the node held
+				NULL if the stack is empty
+
+*******************************************************************************/
+
+void *LFStack_pop (
+	LFStack * list)
+{
+	LFStack_node *node = NULL;
+	void *result = NULL;
+
+	if ((node = LFStack_pop_node (&list->head))) {
+		__sync_fetch_and_sub (&list->length, 1);
+		result = node->data;
+		LFStack_push_chain (&list->spare, node, node);
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to read the head of a lock free stack without popping it
+
+	Arguments:
+				list	the stack
+
+	returns:
+				the data the node holds
+				NULL if the stack is empty
+
+*******************************************************************************/
+
+void *LFStack_read_head (
+	LFStack * list)
+{
+	LFStack_node *node = list->head.node;
+	void *result = NULL;
+
+	if (node)
+		result = node->data;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to count the nodes in a lock free stack
+
+	Arguments:
+				list	the stack
+
+	returns:
+				the number of nodes in the stack
+
+	notes:
+				a node is counted before it is pushed and uncounted after it is
+				popped, so while other threads push the count can be a little
+				high but never wraps below 0
+
+*******************************************************************************/
+
+size_t LFStack_length (
+	LFStack * list)
+{
+	size_t result = list->length;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to move another lock free stack to the head of a lock free stack
+
+	Arguments:
+				dest	the stack you want to move the src to
+				src		the stack you want to move to the dest
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void LFStack_push_list (
+	LFStack * dest,
+	LFStack * src)
+{
+
+	LFStack_pop_all (src, dest);
+
+	return;
+}
+
+/*******************************************************************************
+	function to pop every node from a lock free stack at once
+
+	Arguments:
+				list	the stack
+				dest	the stack to push the nodes onto
+
+	returns:
+				the number of nodes moved
+
+	notes:
+				once taken the chain belongs to this thread, so it can be walked
+				for its tail and count without a race
+
+*******************************************************************************/
+
+size_t LFStack_pop_all (
+	LFStack * list,
+	LFStack * dest)
+{
+	LFStack_node *first = NULL;
+	LFStack_node *last = NULL;
+	size_t result = 1;
+
+	if (!(first = LFStack_take (&list->head)))
+		return 0;
+
+	for (last = first; last->next; last = last->next)
+		result++;
+
+	__sync_fetch_and_sub (&list->length, result);
+
+	__sync_fetch_and_add (&dest->length, result);
+	LFStack_push_chain (&dest->head, first, last);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete all the nodes in a lock free stack
+
+	Arguments:
+				list		the stack
+				function	the function to call to free the data, or NULL
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void LFStack_delete_all (
+	LFStack * list,
+	LFStack_data_free_func function)
+{
+	LFStack_node *node = NULL;
+	LFStack_node *next = NULL;
+
+	for (node = list->head.node; node; node = next) {
+		next = node->next;
+
+		if (function)
+			function (node->data);
+
+		free (node);
+	}
+
+	for (node = list->spare.node; node; node = next) {
+		next = node->next;
+		free (node);
+	}
+
+	list->head.node = NULL;
+	list->spare.node = NULL;
+	list->length = 0;
+
+	return;
+}
@@ -0,0 +1,158 @@
+/*******************************************************************************
+	LLArena.c
+
+	arena allocator
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "../include/LLArena.h"
+
+/*******************************************************************************
+	function to get memory from an arena
+
+	Arguments:
+				arena	the arena
+				size	the number of bytes
+
+	returns:
+				the memory, aligned for any type
+				NULL on error
+
+*******************************************************************************/
+
+void *LLArena_alloc (
+	LLArena *arena,
+	size_t size)
+{
+	LLArena_chunk *chunk = NULL;
+	size_t bytes;
+	void *result = NULL;
+
+	/***** round up to keep the next allocation aligned *****/
+
+	if (size > (size_t) -1 - sizeof (LLArena_chunk) * 2)
+		return NULL;
+
+	size = (size + sizeof (LLArena_chunk) - 1) / sizeof (LLArena_chunk)
+		* sizeof (LLArena_chunk);
+
+	/***** no room in the newest chunk? start a new one *****/
+
+	if (!arena->chunk || size > arena->chunk->head.size - arena->used) {
+		bytes = arena->chunksize ? arena->chunksize : LLARENA_CHUNKSIZE;
+
+		if (bytes < size)
+			bytes = size;
+
+		if (!(chunk = malloc (sizeof (LLArena_chunk) + bytes)))
+			return NULL;
+
+		chunk->head.next = arena->chunk;
+		chunk->head.size = bytes;
+		arena->chunk = chunk;
+		arena->used = 0;
+	}
+
+	result = (char *) (arena->chunk + 1) + arena->used;
+	arena->used += size;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to save a mark in an arena
+
+	Arguments:
+				arena	the arena
+				mark	the mark to fill in
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void LLArena_save (
+	LLArena *arena,
+	LLArena_mark *mark)
+{
+
+	mark->chunk = arena->chunk;
+	mark->used = arena->used;
+
+	return;
+}
+
+/*******************************************************************************
+	function to give back everything an arena handed out since a mark
+
+	Arguments:
+				arena	the arena
+				mark	a mark saved in the arena
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void LLArena_release (
+	LLArena *arena,
+	LLArena_mark *mark)
+{
+	LLArena_chunk *next = NULL;
+
+	while (arena->chunk != mark->chunk) {
+		next = arena->chunk->head.next;
+		free (arena->chunk);
+		arena->chunk = next;
+	}
+
+	arena->used = mark->used;
+
+	return;
+}
+
+/*******************************************************************************
+	function to free all the chunks in an arena at once
+
+	Arguments:
+				arena	the arena
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void LLArena_delete_all (
+	LLArena *arena)
+{
+	LLArena_chunk *next = NULL;
+
+	for (; arena->chunk; arena->chunk = next) {
+		next = arena->chunk->head.next;
+		free (arena->chunk);
+	}
+
+	arena->used = 0;
+
+	return;
+}
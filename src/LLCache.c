@@ -0,0 +1,441 @@
+/*******************************************************************************
+	LLCache.c
+
+	bounded cache with LRU or CLOCK eviction
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "../include/LLPool.h"
+#include "../include/ILList.h"
+#include "../include/LLCache.h"
+
+/***** the entry a link is embedded in *****/
+
+#define ENTRY(l) ILList_entry (l, LLCache_entry, link)
+
+/*******************************************************************************
+	slave function to find the place in the hash index that points to the
+	entry for a key
+
+	returns:
+				the pointer to the entry, *result is NULL if the key is not there
+				NULL if the index is not allocated yet
+*******************************************************************************/
+
+static LLCache_entry **LLCache_find (
+	LLCache *cache,
+	void *key,
+	size_t hash)
+{
+	LLCache_entry **result = NULL;
+
+	if (!cache->table)
+		return NULL;
+
+	for (result = &cache->table[hash & (cache->buckets - 1)];
+			 *result;
+			 result = &(*result)->chain) {
+		if ((*result)->hash == hash && !cache->cmp ((*result)->key, key))
+			break;
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	slave function to double the hash index
+
+	returns:
+				0 on success
+				1 on error, the old index is kept
+*******************************************************************************/
+
+static int LLCache_grow (
+	LLCache *cache)
+{
+	size_t buckets = cache->buckets ? cache->buckets * 2 : LLCACHE_BUCKETS;
+	LLCache_entry **table = NULL;
+	LLCache_entry **slot = NULL;
+	LLCache_entry *entry = NULL;
+	ILList_link *link = NULL;
+
+	if (!(table = calloc (buckets, sizeof (LLCache_entry *))))
+		return 1;
+
+	for (link = cache->list.head; link; link = link->next) {
+		entry = ENTRY (link);
+		slot = &table[entry->hash & (buckets - 1)];
+		entry->chain = *slot;
+		*slot = entry;
+	}
+
+	free (cache->table);
+	cache->table = table;
+	cache->buckets = buckets;
+
+	return 0;
+}
+
+/*******************************************************************************
+	slave function to mark an entry as used
+
+	returns:
+				nothing
+*******************************************************************************/
+
+static void LLCache_touch (
+	LLCache *cache,
+	LLCache_entry *entry)
+{
+
+	if (cache->policy == LLCACHE_CLOCK)
+		entry->ref = 1;
+
+	else if (cache->list.head != &entry->link) {
+		ILList_delete (&cache->list, &entry->link);
+		ILList_prepend (&cache->list, &entry->link);
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to take an entry out of the eviction order, moving the
+	clock hand off it
+
+	returns:
+				nothing
+*******************************************************************************/
+
+static void LLCache_unlink (
+	LLCache *cache,
+	LLCache_entry *entry)
+{
+
+	if (cache->hand == &entry->link)
+		cache->hand = entry->link.next;
+
+	ILList_delete (&cache->list, &entry->link);
+	cache->length--;
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to evict an entry to make room, its data is freed and the
+	entry is handed back for reuse
+
+	returns:
+				the entry
+*******************************************************************************/
+
+static LLCache_entry *LLCache_evict (
+	LLCache *cache)
+{
+	LLCache_entry *result = NULL;
+	LLCache_entry **slot = NULL;
+
+	/***** lru, the tail is the oldest *****/
+
+	if (cache->policy != LLCACHE_CLOCK)
+		result = ENTRY (cache->list.tail);
+
+	/***** clock, give each referenced entry a second chance *****/
+
+	else {
+		for (;;) {
+			if (!cache->hand)
+				cache->hand = cache->list.head;
+
+			result = ENTRY (cache->hand);
+
+			if (!result->ref)
+				break;
+
+			result->ref = 0;
+			cache->hand = cache->hand->next;
+		}
+	}
+
+	for (slot = &cache->table[result->hash & (cache->buckets - 1)];
+			 *slot != result;
+			 slot = &(*slot)->chain) {
+	}
+
+	*slot = result->chain;
+	LLCache_unlink (cache, result);
+	cache->evictions++;
+
+	if (cache->free)
+		cache->free (result->data);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to look up a key in a cache, counting it as a use
+
+	Arguments:
+				cache	the cache
+				key		the key to look for
+
+	returns:
+				the data stored with the key
+				NULL if the key is not in the cache
+
+*******************************************************************************/
+
+void *LLCache_get (
+	LLCache * cache,
+	void *key)
+{
+	LLCache_entry **slot = NULL;
+
+	slot = LLCache_find (cache, key, cache->hash (key));
+
+	if (!slot || !*slot) {
+		cache->misses++;
+		return NULL;
+	}
+
+	cache->hits++;
+	LLCache_touch (cache, *slot);
+
+	return (*slot)->data;
+}
+
+/*******************************************************************************
+	function to look up a key in a cache without counting it as a use
+
+	Arguments:
+				cache	the cache
+				key		the key to look for
+
+	returns:
+				the data stored with the key
+				NULL if the key is not in the cache
+
+*******************************************************************************/
+
+void *LLCache_peek (
+	LLCache * cache,
+	void *key)
+{
+	LLCache_entry **slot = NULL;
+	void *result = NULL;
+
+	slot = LLCache_find (cache, key, cache->hash (key));
+
+	if (slot && *slot)
+		result = (*slot)->data;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to store data in a cache
+
+	Arguments:
+				cache	the cache
+				key		the key to store the data under
+				data	the data
+
+	returns:
+				the data
+				NULL on error
+
+*******************************************************************************/
+
+void *LLCache_put (
+	LLCache * cache,
+	void *key,
+	void *data)
+{
+	size_t hash = cache->hash (key);
+	LLCache_entry **slot = NULL;
+	LLCache_entry *entry = NULL;
+
+	/***** already there? replace the data *****/
+
+	if ((slot = LLCache_find (cache, key, hash)) && (entry = *slot)) {
+		if (cache->free && entry->data != data)
+			cache->free (entry->data);
+
+		entry->key = key;
+		entry->data = data;
+		LLCache_touch (cache, entry);
+
+		return data;
+	}
+
+	/***** full? reuse the evicted entry *****/
+
+	if (cache->capacity && cache->length >= cache->capacity)
+		entry = LLCache_evict (cache);
+
+	else {
+
+		/***** a failed grow leaves longer chains, that is still correct *****/
+
+		if (cache->length >= cache->buckets && LLCache_grow (cache) &&
+				!cache->table)
+			return NULL;
+
+		if (!(entry = LLPool_alloc (&cache->pool, sizeof (LLCache_entry))))
+			return NULL;
+	}
+
+	entry->hash = hash;
+	entry->key = key;
+	entry->data = data;
+	entry->ref = 0;
+
+	slot = &cache->table[hash & (cache->buckets - 1)];
+	entry->chain = *slot;
+	*slot = entry;
+
+	/***** clock, the new entry is the last the hand reaches *****/
+
+	if (cache->policy == LLCACHE_CLOCK && cache->hand)
+		ILList_insert_before (&cache->list, cache->hand, &entry->link);
+	else if (cache->policy == LLCACHE_CLOCK)
+		ILList_append (&cache->list, &entry->link);
+	else
+		ILList_prepend (&cache->list, &entry->link);
+
+	cache->length++;
+
+	return data;
+}
+
+/*******************************************************************************
+	function to remove a key from a cache
+
+	Arguments:
+				cache	the cache
+				key		the key to remove
+
+	returns:
+				the data stored with the key, it is not passed to cache->free
+				NULL if the key is not in the cache
+
+*******************************************************************************/
+
+void *LLCache_delete (
+	LLCache * cache,
+	void *key)
+{
+	LLCache_entry **slot = NULL;
+	LLCache_entry *entry = NULL;
+	void *result = NULL;
+
+	if (!(slot = LLCache_find (cache, key, cache->hash (key))) || !(entry = *slot))
+		return NULL;
+
+	*slot = entry->chain;
+	LLCache_unlink (cache, entry);
+
+	result = entry->data;
+	LLPool_free (&cache->pool, entry);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to count the entries in a cache
+
+	Arguments:
+				cache	the cache
+
+	returns:
+				the number of entries in the cache
+
+*******************************************************************************/
+
+size_t LLCache_length (
+	LLCache * cache)
+{
+	size_t result = cache->length;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete all the entries in a cache
+
+	Arguments:
+				cache	the cache
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void LLCache_delete_all (
+	LLCache * cache)
+{
+	ILList_link *link = NULL;
+
+	if (cache->free) {
+		for (link = cache->list.head; link; link = link->next)
+			cache->free (ENTRY (link)->data);
+	}
+
+	LLPool_delete_all (&cache->pool);
+	free (cache->table);
+
+	cache->table = NULL;
+	cache->buckets = 0;
+	cache->length = 0;
+	cache->list.head = NULL;
+	cache->list.tail = NULL;
+	cache->list.length = 0;
+	cache->hand = NULL;
+
+	return;
+}
+
+/*******************************************************************************
+	function to hash a string key, fnv-1a
+
+	Arguments:
+				key	the string
+
+	returns:
+				the hash of the string
+
+*******************************************************************************/
+
+size_t LLCache_hash_string (
+	void *key)
+{
+	unsigned char *c = key;
+	size_t result = (size_t) 2166136261UL;
+
+	for (; *c; c++) {
+		result ^= *c;
+		result *= 16777619;
+	}
+
+	return result;
+}
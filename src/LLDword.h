@@ -0,0 +1,69 @@
+/*******************************************************************************
+	LLDword.h
+
+	part of libLL
+
+	the double width compare and swap shared by the lock free lists, not
+	installed
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef LLDword_h
+#define LLDword_h
+
+/*******************************************************************************
+	a word twice the size of a pointer, a node and its tag are swapped as one
+	so the tag guards the node against ABA, a swap that only covers the node
+	would silently lose that, so there is no fallback to a narrower one
+
+	LLDWORD_TARGET goes on the functions that do the swap
+	LLDWORD_ORDER () keeps the loads of the tag and the node in order
+*******************************************************************************/
+
+#if __SIZEOF_POINTER__ == 8
+
+#if defined (__x86_64__)
+typedef unsigned __int128 __attribute__ ((may_alias)) LLDword;
+#define LLDWORD_TARGET __attribute__ ((target ("cx16")))
+
+/***** x86 does not reorder loads, the volatile fields keep gcc from it *****/
+
+#define LLDWORD_ORDER()
+
+#elif defined (__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+typedef unsigned __int128 __attribute__ ((may_alias)) LLDword;
+#define LLDWORD_TARGET
+#define LLDWORD_ORDER() __sync_synchronize ()
+
+#else
+#error "the lock free lists need a 16 byte compare and swap on this target"
+#endif
+
+#else
+typedef unsigned long long __attribute__ ((may_alias)) LLDword;
+#define LLDWORD_TARGET
+#define LLDWORD_ORDER() __sync_synchronize ()
+#endif
+
+/***** fails to compile if type is not as wide as LLDword *****/
+
+#define LLDWORD_CHECK(type) \
+	typedef char type##_is_a_dword[sizeof (type) == sizeof (LLDword) ? 1 : -1]
+
+#endif
@@ -0,0 +1,248 @@
+/*******************************************************************************
+	LLPool.c
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "../include/LLPool.h"
+
+/*******************************************************************************
+	function to get a node from a node pool
+
+	Arguments:
+				pool	the pool, or NULL to use malloc
+				size	the size of the node
+
+	returns:
+				the new node
+				NULL on error
+
+  note:
+        size must not be larger than the size the pool was first used with
+*******************************************************************************/
+
+void *LLPool_alloc (
+	LLPool *pool,
+	size_t size)
+{
+	void *result = NULL;
+	LLPool_slab *slab = NULL;
+
+	/***** first use? round the node size up to keep the nodes aligned *****/
+
+	if (pool && !pool->nodesize) {
+		pool->nodesize = (size + sizeof (LLPool_slab) - 1) / sizeof (LLPool_slab)
+			* sizeof (LLPool_slab);
+	}
+
+	/***** no pool? *****/
+
+	if (!pool)
+		result = malloc (size);
+
+	/***** too big for this pool? *****/
+
+	else if (!size || size > pool->nodesize) {
+	}
+
+	/***** is there a returned node? *****/
+
+	else if (pool->free) {
+		result = pool->free;
+		pool->free = pool->free->next;
+		pool->used++;
+	}
+
+	/***** is there an unused node in the newest slab? *****/
+
+	else if (pool->next < pool->end) {
+		result = pool->next;
+		pool->next += pool->nodesize;
+		pool->used++;
+	}
+
+	/***** get a new slab *****/
+
+	else {
+		if (!pool->slabsize)
+			pool->slabsize = LLPOOL_SLABSIZE;
+
+		if ((slab = malloc (sizeof (LLPool_slab) +
+												pool->slabsize * pool->nodesize))) {
+			slab->next = pool->slab;
+			pool->slab = slab;
+			pool->slabs++;
+
+			result = slab + 1;
+			pool->next = (char *) result + pool->nodesize;
+			pool->end = (char *) result + pool->slabsize * pool->nodesize;
+			pool->used++;
+		}
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to get a run of nodes from a node pool in one block
+
+	Arguments:
+				pool	the pool
+				size	the size of each node
+				count	the number of nodes
+
+	returns:
+				the first node, the rest follow every pool->nodesize bytes
+				NULL on error
+
+  note:
+        what is left of the newest slab is put on the free list if the run does
+        not fit in it
+*******************************************************************************/
+
+void *LLPool_alloc_block (
+	LLPool *pool,
+	size_t size,
+	size_t count)
+{
+	void *result = NULL;
+	LLPool_slab *slab = NULL;
+	LLPool_cell *cell = NULL;
+	size_t nodes;
+
+	/***** first use? round the node size up to keep the nodes aligned *****/
+
+	if (!pool->nodesize) {
+		pool->nodesize = (size + sizeof (LLPool_slab) - 1) / sizeof (LLPool_slab)
+			* sizeof (LLPool_slab);
+	}
+
+	if (!pool->slabsize)
+		pool->slabsize = LLPOOL_SLABSIZE;
+
+	/***** too big for this pool? *****/
+
+	if (!size || size > pool->nodesize || !count) {
+	}
+
+	/***** does it fit in the newest slab? *****/
+
+	else if (count <= (size_t) (pool->end - pool->next) / pool->nodesize) {
+		result = pool->next;
+		pool->next += count * pool->nodesize;
+		pool->used += count;
+	}
+
+	/***** get a new slab big enough for the run *****/
+
+	else {
+		nodes = count > pool->slabsize ? count : pool->slabsize;
+
+		if (nodes <= ((size_t) -1 - sizeof (LLPool_slab)) / pool->nodesize &&
+				(slab = malloc (sizeof (LLPool_slab) + nodes * pool->nodesize))) {
+
+			/***** save whats left of the old slab *****/
+
+			for (; pool->next < pool->end; pool->next += pool->nodesize) {
+				cell = (LLPool_cell *) pool->next;
+				cell->next = pool->free;
+				pool->free = cell;
+			}
+
+			slab->next = pool->slab;
+			pool->slab = slab;
+			pool->slabs++;
+
+			result = slab + 1;
+			pool->next = (char *) result + count * pool->nodesize;
+			pool->end = (char *) result + nodes * pool->nodesize;
+			pool->used += count;
+		}
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to return a node to a node pool
+
+	Arguments:
+				pool	the pool, or NULL to use free
+				node	the node to return
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void LLPool_free (
+	LLPool *pool,
+	void *node)
+{
+	LLPool_cell *cell = node;
+
+	if (!pool)
+		free (node);
+
+	else {
+		cell->next = pool->free;
+		pool->free = cell;
+		pool->used--;
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	function to release all the slabs in a node pool at once
+
+	Arguments:
+				pool	the pool
+
+	returns:
+				nothing
+
+  note:
+        every node handed out by the pool becomes invalid, only call this
+        when no list holds nodes from the pool
+*******************************************************************************/
+
+void LLPool_delete_all (
+	LLPool *pool)
+{
+	LLPool_slab *slab = NULL;
+	LLPool_slab *next = NULL;
+
+	for (slab = pool->slab; slab; slab = next) {
+		next = slab->next;
+		free (slab);
+	}
+
+	pool->slab = NULL;
+	pool->slabs = 0;
+	pool->used = 0;
+	pool->free = NULL;
+	pool->next = NULL;
+	pool->end = NULL;
+
+	return;
+}
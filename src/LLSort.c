@@ -0,0 +1,1255 @@
+/*******************************************************************************
+	LLSort.c
+
+	part of libLL
+
+	sorting shared by the single and double linked lists
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "LLSort.h"
+
+/***** wins in a row before a merge starts galloping *****/
+
+#define LLSORT_MIN_GALLOP 7
+
+/***** runs shorter than this are extended with a binary insertion sort *****/
+
+#define LLSORT_MINRUN 32
+
+/***** arrays this short are finished with an insertion sort *****/
+
+#define LLSORT_INSERTION 16
+
+/***** bits of the key sorted on each radix pass *****/
+
+#define LLSORT_RADIX_BITS 8
+#define LLSORT_RADIX (1 << LLSORT_RADIX_BITS)
+
+/***** the run invariants keep the stack under log base phi of SIZE_MAX *****/
+
+#define LLSORT_MAXRUNS 128
+
+#define NEXT(node) LLSORT_NEXT (s->layout, node)
+#define DATA(node) LLSORT_DATA (s->layout, node)
+
+/*******************************************************************************
+	structure for a sorted run of nodes
+*******************************************************************************/
+
+typedef struct {
+	void *head;
+	void *tail;
+	size_t length;
+} LLSort_run;
+
+/*******************************************************************************
+	structure for the state of an adaptive sort
+*******************************************************************************/
+
+typedef struct {
+	LLSort_layout *layout;
+	LLSort_cmp_func cmp;
+	size_t min_gallop;
+	size_t runs;
+	LLSort_run run[LLSORT_MAXRUNS];
+} LLSort_state;
+
+/*******************************************************************************
+	slave function to extend a short run to LLSORT_MINRUN nodes with a binary
+	insertion sort, returns the rest of the chain
+*******************************************************************************/
+
+static void *LLSort_extend_run (
+	LLSort_state *s,
+	LLSort_run *run,
+	void *cur)
+{
+	void *nodes[LLSORT_MINRUN];
+	size_t n = 0;
+	size_t lo;
+	size_t hi;
+	size_t mid;
+	size_t i;
+	void *node = NULL;
+
+	for (node = run->head; node; node = NEXT (node))
+		nodes[n++] = node;
+
+	/***** insert each node after any equal ones to keep the sort stable *****/
+
+	for (; cur && n < LLSORT_MINRUN; n++) {
+		node = cur;
+		cur = NEXT (cur);
+
+		for (lo = 0, hi = n; lo < hi;) {
+			mid = lo + (hi - lo) / 2;
+
+			if (s->cmp (DATA (node), DATA (nodes[mid])) < 0)
+				hi = mid;
+			else
+				lo = mid + 1;
+		}
+
+		for (i = n; i > lo; i--)
+			nodes[i] = nodes[i - 1];
+		nodes[lo] = node;
+	}
+
+	/***** relink *****/
+
+	for (i = 0; i + 1 < n; i++)
+		NEXT (nodes[i]) = nodes[i + 1];
+	NEXT (nodes[n - 1]) = NULL;
+
+	run->head = nodes[0];
+	run->tail = nodes[n - 1];
+	run->length = n;
+
+	return cur;
+}
+
+/*******************************************************************************
+	slave function to cut the next run off the chain, strictly descending runs
+	are reversed, returns the rest of the chain
+*******************************************************************************/
+
+static void *LLSort_next_run (
+	LLSort_state *s,
+	void *node,
+	LLSort_run *run)
+{
+	void *prev = node;
+	void *cur = NEXT (node);
+	void *next = NULL;
+
+	run->head = node;
+	run->tail = node;
+	run->length = 1;
+
+	if (!cur) {
+	}
+
+	/***** descending run? reverse it as we go *****/
+
+	else if (s->cmp (DATA (node), DATA (cur)) > 0) {
+		NEXT (node) = NULL;
+
+		do {
+			next = NEXT (cur);
+			NEXT (cur) = prev;
+			prev = cur;
+			cur = next;
+			run->length++;
+		} while (cur && s->cmp (DATA (prev), DATA (cur)) > 0);
+
+		run->head = prev;
+	}
+
+	/***** ascending run *****/
+
+	else {
+		do {
+			prev = cur;
+			cur = NEXT (cur);
+			run->length++;
+		} while (cur && s->cmp (DATA (prev), DATA (cur)) <= 0);
+
+		run->tail = prev;
+		NEXT (prev) = NULL;
+	}
+
+	/***** short run? extend it *****/
+
+	if (cur && run->length < LLSORT_MINRUN)
+		cur = LLSort_extend_run (s, run, cur);
+
+	return cur;
+}
+
+/*******************************************************************************
+	slave function to count the leading nodes of a chain that belong before
+	key, strict counts only nodes less than key, otherwise nodes less than or
+	equal to key
+
+	the count is found with an exponential then a binary search so it costs
+	log compares, last is set to the last node counted
+*******************************************************************************/
+
+static size_t LLSort_gallop (
+	LLSort_state *s,
+	void *node,
+	void *key,
+	int strict,
+	void **last)
+{
+	size_t lo = 0;
+	size_t hi = 0;
+	size_t idx = 0;
+	size_t target = 0;
+	size_t mid;
+	size_t step = 1;
+	void *cur = node;
+	void *lonode = NULL;
+	int cmp;
+
+	/***** probe nodes 0, 2, 6, 14, ... till one is past key *****/
+
+	for (;;) {
+		target = lo + step - 1;
+
+		for (; cur && idx < target; idx++)
+			cur = NEXT (cur);
+
+		if (!cur) {
+			hi = idx;
+			break;
+		}
+
+		cmp = s->cmp (DATA (cur), key);
+
+		if (strict ? cmp < 0 : cmp <= 0) {
+			lo = target + 1;
+			lonode = cur;
+			step *= 2;
+		}
+		else {
+			hi = target;
+			break;
+		}
+	}
+
+	/***** binary search the nodes between the last 2 probes *****/
+
+	cur = lonode ? NEXT (lonode) : node;
+
+	while (lo < hi) {
+		void *m = cur;
+
+		mid = lo + (hi - lo) / 2;
+
+		for (idx = lo; idx < mid; idx++)
+			m = NEXT (m);
+
+		cmp = s->cmp (DATA (m), key);
+
+		if (strict ? cmp < 0 : cmp <= 0) {
+			lo = mid + 1;
+			lonode = m;
+			cur = NEXT (m);
+		}
+		else
+			hi = mid;
+	}
+
+	*last = lonode;
+
+	return lo;
+}
+
+/*******************************************************************************
+	slave function to merge 2 runs, a comes before b in the list
+*******************************************************************************/
+
+static void LLSort_merge (
+	LLSort_state *s,
+	LLSort_run *a,
+	LLSort_run *b)
+{
+	void *x = a->head;
+	void *y = b->head;
+	void *head = NULL;
+	void *tail = NULL;
+	void *last = NULL;
+	size_t xwins = 0;
+	size_t ywins = 0;
+	size_t k = 0;
+	size_t k2 = 0;
+
+	a->length += b->length;
+
+	/***** already in order? *****/
+
+	if (s->cmp (DATA (a->tail), DATA (b->head)) <= 0) {
+		NEXT (a->tail) = b->head;
+		a->tail = b->tail;
+
+		return;
+	}
+
+	while (x && y) {
+
+		/***** one at a time *****/
+
+		if (s->cmp (DATA (y), DATA (x)) < 0) {
+			last = y;
+			y = NEXT (y);
+			ywins++;
+			xwins = 0;
+		}
+		else {
+			last = x;
+			x = NEXT (x);
+			xwins++;
+			ywins = 0;
+		}
+
+		if (!head)
+			head = last;
+		else
+			NEXT (tail) = last;
+		tail = last;
+
+		/***** one run keeps winning? gallop *****/
+
+		if (x && y && (xwins >= s->min_gallop || ywins >= s->min_gallop)) {
+			do {
+				if ((k = LLSort_gallop (s, x, DATA (y), 0, &last))) {
+					NEXT (tail) = x;
+					tail = last;
+					x = NEXT (last);
+				}
+
+				if (!x)
+					break;
+
+				if ((k2 = LLSort_gallop (s, y, DATA (x), 1, &last))) {
+					NEXT (tail) = y;
+					tail = last;
+					y = NEXT (last);
+				}
+
+				if (!y)
+					break;
+
+				if (s->min_gallop > 1)
+					s->min_gallop--;
+
+			} while (k >= LLSORT_MIN_GALLOP || k2 >= LLSORT_MIN_GALLOP);
+
+			s->min_gallop += 2;
+			xwins = 0;
+			ywins = 0;
+		}
+	}
+
+	/***** add whats left *****/
+
+	if (x) {
+		NEXT (tail) = x;
+		tail = a->tail;
+	}
+	else {
+		NEXT (tail) = y;
+		tail = b->tail;
+	}
+
+	a->head = head;
+	a->tail = tail;
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to merge run i and i + 1 on the run stack
+*******************************************************************************/
+
+static void LLSort_merge_at (
+	LLSort_state *s,
+	size_t i)
+{
+
+	LLSort_merge (s, s->run + i, s->run + i + 1);
+
+	if (i + 3 == s->runs)
+		s->run[i + 1] = s->run[i + 2];
+
+	s->runs--;
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to merge runs on the stack till the lengths satisfy the
+	TimSort invariants
+*******************************************************************************/
+
+static void LLSort_collapse (
+	LLSort_state *s)
+{
+	LLSort_run *r = s->run;
+	size_t k;
+
+	while (s->runs > 1) {
+		k = s->runs - 2;
+
+		if ((k > 0 && r[k - 1].length <= r[k].length + r[k + 1].length) ||
+				(k > 1 && r[k - 2].length <= r[k - 1].length + r[k].length)) {
+			if (r[k - 1].length < r[k + 1].length)
+				k--;
+		}
+
+		else if (r[k].length > r[k + 1].length)
+			break;
+
+		LLSort_merge_at (s, k);
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	function to sort a null terminated chain of nodes with a natural merge sort
+
+	Arguments:
+				layout		where the next and data pointers are in a node
+				head		the first node of the chain
+				cmp_func	function to compare the data in 2 nodes
+				tail		set to the last node of the sorted chain
+
+	returns:
+				the first node of the sorted chain
+
+	notes:
+				ascending and strictly descending runs already in the chain are
+				found and merged TimSort style, with galloping when one run keeps
+				winning, so sorted or reversed input costs n - 1 compares
+				only the next pointers are set, the sort is stable
+*******************************************************************************/
+
+void *LLSort_adaptive (
+	LLSort_layout *layout,
+	void *head,
+	LLSort_cmp_func cmp_func,
+	void **tail)
+{
+	LLSort_state state;
+	LLSort_state *s = &state;
+	void *node = head;
+	size_t k;
+
+	if (!head) {
+		*tail = NULL;
+		return NULL;
+	}
+
+	s->layout = layout;
+	s->cmp = cmp_func;
+	s->min_gallop = LLSORT_MIN_GALLOP;
+	s->runs = 0;
+
+	/***** cut the chain into runs merging as we go *****/
+
+	while (node) {
+		node = LLSort_next_run (s, node, s->run + s->runs);
+		s->runs++;
+		LLSort_collapse (s);
+	}
+
+	/***** merge whats left on the stack *****/
+
+	while (s->runs > 1) {
+		k = s->runs - 2;
+
+		if (k > 0 && s->run[k - 1].length < s->run[k + 1].length)
+			k--;
+
+		LLSort_merge_at (s, k);
+	}
+
+	*tail = s->run[0].tail;
+
+	return s->run[0].head;
+}
+
+/*******************************************************************************
+	structure for one thread of a parallel sort, a segment to sort or the 2
+	runs to merge, or with arrays its part of each round of merges
+
+	src		the nodes, each run between 2 bounds sorted
+	dst		where the merged runs go, for a sort where the segment goes
+	bound	the bounds of the runs in src
+	nruns	the number of runs in src
+	first	the first place in dst this thread fills
+	last	one past the last place in dst this thread fills
+*******************************************************************************/
+
+typedef struct {
+	LLSort_layout *layout;
+	LLSort_cmp_func cmp;
+	LLSort_run a;
+	LLSort_run b;
+	void **src;
+	void **dst;
+	size_t *bound;
+	size_t nruns;
+	size_t first;
+	size_t last;
+} LLSort_job;
+
+/*******************************************************************************
+	slave thread function to sort a segment
+*******************************************************************************/
+
+static void *LLSort_sort_job (
+	void *extra)
+{
+	LLSort_job *job = extra;
+
+	void *node = NULL;
+	void **dst = job->dst;
+
+	job->a.head = LLSort_adaptive (job->layout, job->a.head, job->cmp,
+																 &job->a.tail);
+
+	/***** put the sorted segment in its place in the array *****/
+
+	if (dst) {
+		for (node = job->a.head; node; node = LLSORT_NEXT (job->layout, node))
+			*dst++ = node;
+	}
+
+	return NULL;
+}
+
+/*******************************************************************************
+	slave thread function to merge 2 runs
+*******************************************************************************/
+
+static void *LLSort_merge_job (
+	void *extra)
+{
+	LLSort_job *job = extra;
+	LLSort_state state;
+
+	state.layout = job->layout;
+	state.cmp = job->cmp;
+	state.min_gallop = LLSORT_MIN_GALLOP;
+	state.runs = 0;
+
+	LLSort_merge (&state, &job->a, &job->b);
+
+	return NULL;
+}
+
+/*******************************************************************************
+	slave function to find where the first k nodes of the merge of 2 sorted
+	arrays come from, the merge path, with ties going to a so the merge is
+	stable
+
+	returns:
+				the number of the k nodes that come from a, the rest come from b
+*******************************************************************************/
+
+static size_t LLSort_corank (
+	LLSort_job *job,
+	size_t k,
+	void **a,
+	size_t alen,
+	void **b,
+	size_t blen)
+{
+	LLSort_layout *layout = job->layout;
+	size_t i = k < alen ? k : alen;
+	size_t j = k - i;
+	size_t ilo = k > blen ? k - blen : 0;
+	size_t jlo = k > alen ? k - alen : 0;
+	size_t d;
+
+	for (;;) {
+
+		/***** too many from a? *****/
+
+		if (i > 0 && j < blen &&
+				job->cmp (LLSORT_DATA (layout, a[i - 1]),
+									LLSORT_DATA (layout, b[j])) > 0) {
+			d = (i - ilo + 1) / 2;
+			jlo = j;
+			i -= d;
+			j += d;
+		}
+
+		/***** too many from b? *****/
+
+		else if (j > 0 && i < alen &&
+						 job->cmp (LLSORT_DATA (layout, b[j - 1]),
+											 LLSORT_DATA (layout, a[i])) >= 0) {
+			d = (j - jlo + 1) / 2;
+			ilo = i;
+			i += d;
+			j -= d;
+		}
+
+		else
+			break;
+	}
+
+	return i;
+}
+
+/*******************************************************************************
+	slave thread function to fill its part of each merge of a round, the
+	runs in src are merged in pairs into dst, an odd run out is copied
+*******************************************************************************/
+
+static void *LLSort_path_job (
+	void *extra)
+{
+	LLSort_job *job = extra;
+	LLSort_layout *layout = job->layout;
+	size_t *bound = job->bound;
+	void **a = NULL;
+	void **b = NULL;
+	void **dst = NULL;
+	size_t alen;
+	size_t blen;
+	size_t first;
+	size_t last;
+	size_t i;
+	size_t j;
+	size_t iend;
+	size_t jend;
+	size_t p;
+
+	for (p = 0; p < job->nruns; p += 2) {
+
+		/***** the part of this merge that is ours *****/
+
+		first = bound[p] > job->first ? bound[p] : job->first;
+		last = bound[p + 2 < job->nruns ? p + 2 : job->nruns];
+		last = last < job->last ? last : job->last;
+
+		if (first >= last)
+			continue;
+
+		a = job->src + bound[p];
+		alen = bound[p + 1] - bound[p];
+		b = a + alen;
+		blen = p + 1 < job->nruns ? bound[p + 2] - bound[p + 1] : 0;
+		dst = job->dst + first;
+
+		i = LLSort_corank (job, first - bound[p], a, alen, b, blen);
+		j = first - bound[p] - i;
+		iend = LLSort_corank (job, last - bound[p], a, alen, b, blen);
+		jend = last - bound[p] - iend;
+
+		while (i < iend && j < jend) {
+			if (job->cmp (LLSORT_DATA (layout, b[j]),
+										LLSORT_DATA (layout, a[i])) < 0)
+				*dst++ = b[j++];
+			else
+				*dst++ = a[i++];
+		}
+
+		while (i < iend)
+			*dst++ = a[i++];
+
+		while (j < jend)
+			*dst++ = b[j++];
+	}
+
+	return NULL;
+}
+
+/*******************************************************************************
+	slave thread function to link its part of the sorted array into a chain
+*******************************************************************************/
+
+static void *LLSort_link_job (
+	void *extra)
+{
+	LLSort_job *job = extra;
+	size_t i;
+
+	for (i = job->first; i < job->last; i++) {
+		LLSORT_NEXT (job->layout, job->src[i]) =
+			i + 1 < job->bound[job->nruns] ? job->src[i + 1] : NULL;
+	}
+
+	return NULL;
+}
+
+/*******************************************************************************
+	slave function to run a job in each thread and wait for them, if a thread
+	cant be started its job is run in the calling thread
+*******************************************************************************/
+
+static void LLSort_run_jobs (
+	LLSort_job *jobs,
+	size_t njobs,
+	void *(*function) (void *))
+{
+	pthread_t threads[LLSORT_MAXTHREADS];
+	int started[LLSORT_MAXTHREADS];
+	size_t i;
+
+	for (i = 1; i < njobs; i++)
+		started[i] = !pthread_create (threads + i, NULL, function, jobs + i);
+
+	function (jobs);
+
+	for (i = 1; i < njobs; i++) {
+		if (started[i])
+			pthread_join (threads[i], NULL);
+		else
+			function (jobs + i);
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	function to sort a null terminated chain of nodes with several threads
+
+	Arguments:
+				layout		where the next and data pointers are in a node
+				head		the first node of the chain
+				length		the number of nodes in the chain
+				cmp_func	function to compare the data in 2 nodes
+				threads		the number of threads to use
+				tail		set to the last node of the sorted chain
+
+	returns:
+				the first node of the sorted chain
+
+	notes:
+				the chain is cut into one segment per thread, the segments are sorted
+				at the same time with LLSort_adaptive () then merged in pairs
+				every round of merges, the last one too, is split evenly across
+				all the threads on the merge path, so it takes 2 arrays of length
+				pointers, if they can not be allocated each merge of a round runs
+				in its own thread and the last merge is serial
+				cmp_func is called from several threads at once
+				only the next pointers are set, the sort is stable
+*******************************************************************************/
+
+void *LLSort_parallel (
+	LLSort_layout *layout,
+	void *head,
+	size_t length,
+	LLSort_cmp_func cmp_func,
+	size_t threads,
+	void **tail)
+{
+	LLSort_job jobs[LLSORT_MAXTHREADS];
+	LLSort_run runs[LLSORT_MAXTHREADS];
+	size_t bound[LLSORT_MAXTHREADS + 1];
+	void **array = NULL;
+	void **spare = NULL;
+	void **swap = NULL;
+	void *node = head;
+	size_t nruns;
+	size_t njobs;
+	size_t seglen;
+	size_t i;
+	size_t j;
+
+	if (threads > LLSORT_MAXTHREADS)
+		threads = LLSORT_MAXTHREADS;
+
+	if (threads > length)
+		threads = length;
+
+	if (threads < 2)
+		return LLSort_adaptive (layout, head, cmp_func, tail);
+
+	/***** with 2 arrays of the nodes every merge can be split *****/
+
+	if ((array = malloc (2 * length * sizeof (void *))))
+		spare = array + length;
+
+	/***** cut the chain into segments *****/
+
+	for (i = 0, bound[0] = 0; i < threads; i++) {
+		seglen = length / threads + (i < length % threads);
+		bound[i + 1] = bound[i] + seglen;
+
+		jobs[i].layout = layout;
+		jobs[i].cmp = cmp_func;
+		jobs[i].a.head = node;
+		jobs[i].a.length = seglen;
+		jobs[i].dst = array ? array + bound[i] : NULL;
+
+		for (j = 1; j < seglen; j++)
+			node = LLSORT_NEXT (layout, node);
+
+		jobs[i].a.tail = node;
+		node = LLSORT_NEXT (layout, node);
+		LLSORT_NEXT (layout, jobs[i].a.tail) = NULL;
+	}
+
+	/***** sort the segments *****/
+
+	LLSort_run_jobs (jobs, threads, LLSort_sort_job);
+
+	/***** merge pairs of runs, each thread takes a share of every round *****/
+
+	if (array) {
+		for (nruns = threads; nruns > 1; nruns = (nruns + 1) / 2) {
+			for (i = 0; i < threads; i++) {
+				jobs[i].src = array;
+				jobs[i].dst = spare;
+				jobs[i].bound = bound;
+				jobs[i].nruns = nruns;
+				jobs[i].first = length * i / threads;
+				jobs[i].last = length * (i + 1) / threads;
+			}
+
+			LLSort_run_jobs (jobs, threads, LLSort_path_job);
+
+			for (i = 1; 2 * i <= nruns; i++)
+				bound[i] = bound[2 * i];
+
+			bound[i] = length;
+
+			swap = array;
+			array = spare;
+			spare = swap;
+		}
+
+		/***** link the nodes in their new order *****/
+
+		for (i = 0; i < threads; i++) {
+			jobs[i].src = array;
+			jobs[i].bound = bound;
+			jobs[i].nruns = 1;
+		}
+
+		LLSort_run_jobs (jobs, threads, LLSort_link_job);
+
+		head = array[0];
+		*tail = array[length - 1];
+
+		free (array < spare ? array : spare);
+
+		return head;
+	}
+
+	/***** no arrays, merge pairs of runs a round at a time *****/
+
+	for (i = 0; i < threads; i++)
+		runs[i] = jobs[i].a;
+
+	for (nruns = threads; nruns > 1; nruns = njobs + (nruns & 1)) {
+		for (njobs = 0; 2 * njobs + 1 < nruns; njobs++) {
+			jobs[njobs].a = runs[2 * njobs];
+			jobs[njobs].b = runs[2 * njobs + 1];
+		}
+
+		LLSort_run_jobs (jobs, njobs, LLSort_merge_job);
+
+		for (i = 0; i < njobs; i++)
+			runs[i] = jobs[i].a;
+
+		/***** odd run out moves down *****/
+
+		if (nruns & 1)
+			runs[njobs] = runs[nruns - 1];
+	}
+
+	*tail = runs[0].tail;
+
+	return runs[0].head;
+}
+
+/*******************************************************************************
+	structure for the state of an array sort, with no layout the array is
+	sorted by the addresses of the nodes
+*******************************************************************************/
+
+typedef struct {
+	LLSort_layout *layout;
+	LLSort_cmp_func cmp;
+} LLSort_keys;
+
+/*******************************************************************************
+	slave function to test if node a sorts before node b
+*******************************************************************************/
+
+static int LLSort_less (
+	LLSort_keys *s,
+	void *a,
+	void *b)
+{
+	int result;
+
+	if (s->layout)
+		result = s->cmp (DATA (a), DATA (b)) < 0;
+	else
+		result = (size_t) a < (size_t) b;
+
+	return result;
+}
+
+/*******************************************************************************
+	slave function to sift a node down a heap
+*******************************************************************************/
+
+static void LLSort_sift (
+	LLSort_keys *s,
+	void **array,
+	size_t i,
+	size_t n)
+{
+	void *node = array[i];
+	size_t child;
+
+	while ((child = 2 * i + 1) < n) {
+		if (child + 1 < n && LLSort_less (s, array[child], array[child + 1]))
+			child++;
+
+		if (!LLSort_less (s, node, array[child]))
+			break;
+
+		array[i] = array[child];
+		i = child;
+	}
+
+	array[i] = node;
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to heapsort an array of nodes, used when the quicksort
+	recurses too deep
+*******************************************************************************/
+
+static void LLSort_heapsort (
+	LLSort_keys *s,
+	void **array,
+	size_t n)
+{
+	void *node = NULL;
+	size_t i;
+
+	for (i = n / 2; i > 0; i--)
+		LLSort_sift (s, array, i - 1, n);
+
+	for (i = n - 1; i > 0; i--) {
+		node = array[0];
+		array[0] = array[i];
+		array[i] = node;
+		LLSort_sift (s, array, 0, i);
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to introsort an array of nodes, a median of 3 quicksort
+	that falls back to heapsort after depth levels and leaves short
+	partitions for the final insertion sort
+*******************************************************************************/
+
+static void LLSort_introsort (
+	LLSort_keys *s,
+	void **array,
+	size_t n,
+	size_t depth)
+{
+	void *pivot = NULL;
+	void *node = NULL;
+	size_t mid;
+	size_t i;
+	size_t j;
+
+	while (n > LLSORT_INSERTION) {
+		if (!depth--) {
+			LLSort_heapsort (s, array, n);
+			return;
+		}
+
+		/***** median of the first, middle and last as the pivot *****/
+
+		mid = n / 2;
+
+		if (LLSort_less (s, array[mid], array[0])) {
+			node = array[mid]; array[mid] = array[0]; array[0] = node;
+		}
+		if (LLSort_less (s, array[n - 1], array[mid])) {
+			node = array[mid]; array[mid] = array[n - 1]; array[n - 1] = node;
+			if (LLSort_less (s, array[mid], array[0])) {
+				node = array[mid]; array[mid] = array[0]; array[0] = node;
+			}
+		}
+
+		pivot = array[mid];
+
+		/***** partition, the first and last are already on the right side *****/
+
+		for (i = 0, j = n - 1;;) {
+			while (LLSort_less (s, array[++i], pivot)) {
+			}
+			while (LLSort_less (s, pivot, array[--j])) {
+			}
+
+			if (i >= j)
+				break;
+
+			node = array[i];
+			array[i] = array[j];
+			array[j] = node;
+		}
+
+		/***** recurse into the smaller side, loop on the larger *****/
+
+		if (i < n - i) {
+			LLSort_introsort (s, array, i, depth);
+			array += i;
+			n -= i;
+		}
+		else {
+			LLSort_introsort (s, array + i, n - i, depth);
+			n = i;
+		}
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to sort an array of nodes
+*******************************************************************************/
+
+static void LLSort_sort_array (
+	LLSort_keys *s,
+	void **array,
+	size_t n)
+{
+	void *node = NULL;
+	size_t depth = 0;
+	size_t i;
+	size_t j;
+
+	for (i = n; i > 1; i >>= 1)
+		depth += 2;
+
+	LLSort_introsort (s, array, n, depth);
+
+	/***** one insertion sort over the whole array finishes it *****/
+
+	for (i = 1; i < n; i++) {
+		node = array[i];
+
+		for (j = i; j > 0 && LLSort_less (s, node, array[j - 1]); j--)
+			array[j] = array[j - 1];
+
+		array[j] = node;
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	function to sort a null terminated chain of nodes in an array
+
+	Arguments:
+				layout		where the next and data pointers are in a node
+				head		the first node of the chain, set to the first node of the
+									sorted chain
+				length		the number of nodes in the chain
+				cmp_func	function to compare the data in 2 nodes
+				relocate	non zero to move the data instead of the nodes
+				tail		set to the last node of the sorted chain
+
+	returns:
+				0 on success
+				1 if the array could not be allocated, the chain is untouched
+
+	notes:
+				the node pointers are gathered into an array, introsorted and the
+				chain relinked in one pass, the sort is not stable
+				with relocate the nodes are linked in address order and the sorted
+				data is written into them, so walking the chain walks memory forward
+*******************************************************************************/
+
+int LLSort_array (
+	LLSort_layout *layout,
+	void **head,
+	size_t length,
+	LLSort_cmp_func cmp_func,
+	int relocate,
+	void **tail)
+{
+	LLSort_keys keys;
+	LLSort_keys *s = &keys;
+	void **array = NULL;
+	void **data = NULL;
+	void *node = NULL;
+	size_t i;
+
+	if (!length) {
+		*tail = NULL;
+		return 0;
+	}
+
+	if (!(array = malloc (length * sizeof (void *))))
+		return 1;
+
+	if (relocate && !(data = malloc (length * sizeof (void *)))) {
+		free (array);
+		return 1;
+	}
+
+	s->layout = layout;
+	s->cmp = cmp_func;
+
+	for (i = 0, node = *head; i < length; i++, node = NEXT (node))
+		array[i] = node;
+
+	LLSort_sort_array (s, array, length);
+
+	/***** move the data into the nodes in address order *****/
+
+	if (relocate) {
+		for (i = 0; i < length; i++)
+			data[i] = DATA (array[i]);
+
+		s->layout = NULL;
+		LLSort_sort_array (s, array, length);
+		s->layout = layout;
+
+		for (i = 0; i < length; i++)
+			DATA (array[i]) = data[i];
+
+		free (data);
+	}
+
+	/***** relink *****/
+
+	for (i = 0; i + 1 < length; i++)
+		NEXT (array[i]) = array[i + 1];
+	NEXT (array[length - 1]) = NULL;
+
+	*head = array[0];
+	*tail = array[length - 1];
+
+	free (array);
+
+	return 0;
+}
+
+/*******************************************************************************
+	structure for the state of a radix sort
+*******************************************************************************/
+
+typedef struct {
+	LLSort_layout *layout;
+	LLSort_key_func key;
+} LLSort_digits;
+
+/*******************************************************************************
+	function to sort a null terminated chain of nodes by an integer key with an
+	LSD radix sort
+
+	Arguments:
+				layout		where the next and data pointers are in a node
+				head		the first node of the chain
+				key_func	function to get the key of the data in a node
+				tail		set to the last node of the sorted chain
+
+	returns:
+				the first node of the sorted chain
+
+	notes:
+				one byte of the key is sorted on each pass by dealing the nodes into
+				256 buckets, bytes that are the same in every key are skipped
+				nothing is allocated, the sort is stable
+*******************************************************************************/
+
+void *LLSort_radix (
+	LLSort_layout *layout,
+	void *head,
+	LLSort_key_func key_func,
+	void **tail)
+{
+	LLSort_digits digits;
+	LLSort_digits *s = &digits;
+	void *heads[LLSORT_RADIX];
+	void *tails[LLSORT_RADIX];
+	void *node = NULL;
+	void *last = NULL;
+	unsigned long long key;
+	unsigned long long all_or = 0;
+	unsigned long long all_and = ~0ULL;
+	unsigned int shift;
+	size_t d;
+
+	if (!head) {
+		*tail = NULL;
+		return NULL;
+	}
+
+	s->layout = layout;
+	s->key = key_func;
+
+	/***** find the bytes that differ between the keys *****/
+
+	for (node = head; node; node = NEXT (node)) {
+		key = s->key (DATA (node));
+		all_or |= key;
+		all_and &= key;
+		last = node;
+	}
+
+	for (shift = 0; shift < sizeof (key) * 8; shift += LLSORT_RADIX_BITS) {
+		if (!(((all_or ^ all_and) >> shift) & (LLSORT_RADIX - 1)))
+			continue;
+
+		for (d = 0; d < LLSORT_RADIX; d++)
+			heads[d] = NULL;
+
+		/***** deal the nodes into the buckets in order *****/
+
+		for (node = head; node; node = NEXT (node)) {
+			d = (s->key (DATA (node)) >> shift) & (LLSORT_RADIX - 1);
+
+			if (!heads[d])
+				heads[d] = node;
+			else
+				NEXT (tails[d]) = node;
+			tails[d] = node;
+		}
+
+		/***** join the buckets back up *****/
+
+		head = NULL;
+
+		for (d = 0; d < LLSORT_RADIX; d++) {
+			if (!heads[d])
+				continue;
+
+			if (!head)
+				head = heads[d];
+			else
+				NEXT (last) = heads[d];
+			last = tails[d];
+		}
+
+		NEXT (last) = NULL;
+	}
+
+	*tail = last;
+
+	return head;
+}
@@ -0,0 +1,184 @@
+/*******************************************************************************
+	LLSort.h
+
+	part of libLL
+
+	sorting shared by the single and double linked lists, not installed
+
+  Copyright (C) 2005-2007  winkey
+
+  This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#ifndef LLSort_h
+#define LLSort_h
+
+#include <stddef.h>
+
+/*******************************************************************************
+	type of function to compare the data in 2 nodes
+*******************************************************************************/
+
+typedef int (*LLSort_cmp_func) (
+	void *data1,
+	void *data2);
+
+/*******************************************************************************
+	type of function to get the integer key of the data in a node
+*******************************************************************************/
+
+typedef unsigned long long (*LLSort_key_func) (
+	void *data);
+
+/*******************************************************************************
+	structure describing where the next and data pointers are in a node
+
+	next  offset of the next pointer in the node
+	data  offset of the data pointer in the node
+*******************************************************************************/
+
+typedef struct {
+	size_t next;
+	size_t data;
+} LLSort_layout;
+
+/*******************************************************************************
+	the most threads LLSort_parallel () will use
+*******************************************************************************/
+
+#define LLSORT_MAXTHREADS 64
+
+#define LLSORT_NEXT(layout, node) \
+	(*(void **) ((char *) (node) + (layout)->next))
+
+#define LLSORT_DATA(layout, node) \
+	(*(void **) ((char *) (node) + (layout)->data))
+
+/*******************************************************************************
+	function to sort a null terminated chain of nodes with a natural merge sort
+
+	Arguments:
+				layout		where the next and data pointers are in a node
+				head		the first node of the chain
+				cmp_func	function to compare the data in 2 nodes
+				tail		set to the last node of the sorted chain
+
+	returns:
+				the first node of the sorted chain
+
+	notes:
+				ascending and strictly descending runs already in the chain are
+				found and merged TimSort style, with galloping when one run keeps
+				winning, so sorted or reversed input costs n - 1 compares
+				only the next pointers are set, the sort is stable
+*******************************************************************************/
+
+void *LLSort_adaptive (
+	LLSort_layout *layout,
+	void *head,
+	LLSort_cmp_func cmp_func,
+	void **tail);
+
+/*******************************************************************************
+	function to sort a null terminated chain of nodes with several threads
+
+	Arguments:
+				layout		where the next and data pointers are in a node
+				head		the first node of the chain
+				length		the number of nodes in the chain
+				cmp_func	function to compare the data in 2 nodes
+				threads		the number of threads to use
+				tail		set to the last node of the sorted chain
+
+	returns:
+				the first node of the sorted chain
+
+	notes:
+				the chain is cut into one segment per thread, the segments are sorted
+				at the same time with LLSort_adaptive () then merged in pairs
+				every round of merges, the last one too, is split evenly across
+				all the threads on the merge path, so it takes 2 arrays of length
+				pointers, if they can not be allocated each merge of a round runs
+				in its own thread and the last merge is serial
+				cmp_func is called from several threads at once
+				only the next pointers are set, the sort is stable
+*******************************************************************************/
+
+void *LLSort_parallel (
+	LLSort_layout *layout,
+	void *head,
+	size_t length,
+	LLSort_cmp_func cmp_func,
+	size_t threads,
+	void **tail);
+
+/*******************************************************************************
+	function to sort a null terminated chain of nodes in an array
+
+	Arguments:
+				layout		where the next and data pointers are in a node
+				head		the first node of the chain, set to the first node of the
+									sorted chain
+				length		the number of nodes in the chain
+				cmp_func	function to compare the data in 2 nodes
+				relocate	non zero to move the data instead of the nodes
+				tail		set to the last node of the sorted chain
+
+	returns:
+				0 on success
+				1 if the array could not be allocated, the chain is untouched
+
+	notes:
+				the node pointers are gathered into an array, introsorted and the
+				chain relinked in one pass, the sort is not stable
+				with relocate the nodes are linked in address order and the sorted
+				data is written into them, so walking the chain walks memory forward
+*******************************************************************************/
+
+int LLSort_array (
+	LLSort_layout *layout,
+	void **head,
+	size_t length,
+	LLSort_cmp_func cmp_func,
+	int relocate,
+	void **tail);
+
+/*******************************************************************************
+	function to sort a null terminated chain of nodes by an integer key with an
+	LSD radix sort
+
+	Arguments:
+				layout		where the next and data pointers are in a node
+				head		the first node of the chain
+				key_func	function to get the key of the data in a node
+				tail		set to the last node of the sorted chain
+
+	returns:
+				the first node of the sorted chain
+
+	notes:
+				one byte of the key is sorted on each pass by dealing the nodes into
+				256 buckets, bytes that are the same in every key are skipped
+				nothing is allocated, the sort is stable
+*******************************************************************************/
+
+void *LLSort_radix (
+	LLSort_layout *layout,
+	void *head,
+	LLSort_key_func key_func,
+	void **tail);
+
+#endif
@@ -0,0 +1,437 @@
+/*******************************************************************************
+	MPQueue.c
+
+	bounded multi producer multi consumer fifo
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <sched.h>
+#include "../include/MPQueue.h"
+
+/***** a slot's data must be written before its sequence hands it over *****/
+
+#if defined (__x86_64__) || defined (__i386__)
+
+/***** x86 keeps stores in order and loads in order, only gcc must not move them *****/
+
+#define MPQUEUE_ORDER() __asm__ __volatile__ ("" : : : "memory")
+
+#else
+#define MPQUEUE_ORDER() __sync_synchronize ()
+#endif
+
+/*******************************************************************************
+	slave function to allocate the buffer on the first push, the first thread
+	in does it and any others wait
+
+	returns:
+				0 on success
+				-1 on error
+*******************************************************************************/
+
+static int MPQueue_start (
+	MPQueue *list)
+{
+	MPQueue_cell *buffer = NULL;
+	size_t size = 1;
+	size_t i;
+
+	while (list->state != 2) {
+		if (!list->state && __sync_bool_compare_and_swap (&list->state, 0, 1)) {
+			if (!list->size)
+				list->size = MPQUEUE_SIZE;
+
+			/***** too big to round up to a power of 2 and allocate? *****/
+
+			if (list->size <= SIZE_MAX / sizeof (MPQueue_cell) / 2 + 1) {
+				while (size < list->size)
+					size <<= 1;
+
+				buffer = malloc (size * sizeof (MPQueue_cell));
+			}
+
+			if (!buffer) {
+				list->state = 0;
+				return -1;
+			}
+
+			for (i = 0; i < size; i++)
+				buffer[i].seq = i;
+
+			list->size = size;
+			list->mask = size - 1;
+			list->buffer = buffer;
+
+			__sync_synchronize ();
+			list->state = 2;
+		}
+
+		else
+			sched_yield ();
+	}
+
+	MPQUEUE_ORDER ();
+
+	return 0;
+}
+
+/*******************************************************************************
+	slave function to claim a run of slots that are ready
+
+	Arguments:
+				list		the que
+				pos			the position to claim from, the head or the tail
+				ready		0 to claim free slots, 1 to claim full ones
+				count		the most slots to claim
+				start		set to the first position claimed
+
+	returns:
+				the number of slots claimed
+				0 if the first slot is not ready, the que is full or empty
+
+	notes:
+				a slot ready for position p can only be changed by the thread
+				that claims p, so once the swap moves pos past the run the run
+				belongs to this thread
+*******************************************************************************/
+
+static size_t MPQueue_claim (
+	MPQueue *list,
+	volatile size_t *pos,
+	size_t ready,
+	size_t count,
+	size_t *start)
+{
+	size_t p;
+	size_t n;
+	size_t seq = 0;
+
+	while (1) {
+		p = *pos;
+
+		for (n = 0; n < count; n++) {
+			seq = list->buffer[(p + n) & list->mask].seq;
+
+			if (seq != p + n + ready)
+				break;
+		}
+
+		/***** the slot is a lap behind, or another thread got here first *****/
+
+		if (!n) {
+			if ((long) (seq - (p + ready)) < 0)
+				return 0;
+		}
+
+		else if (__sync_bool_compare_and_swap (pos, p, p + n)) {
+			MPQUEUE_ORDER ();
+			*start = p;
+			return n;
+		}
+	}
+}
+
+/*******************************************************************************
+	slave function to fill a claimed run and hand it to the consumers
+*******************************************************************************/
+
+static void MPQueue_fill (
+	MPQueue *list,
+	size_t start,
+	void **array,
+	size_t count)
+{
+	MPQueue_cell *cell = NULL;
+	size_t i;
+
+	for (i = 0; i < count; i++) {
+		cell = list->buffer + ((start + i) & list->mask);
+		cell->data = array[i];
+		MPQUEUE_ORDER ();
+		cell->seq = start + i + 1;
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to empty a claimed run and hand it back to the producers
+*******************************************************************************/
+
+static void MPQueue_empty (
+	MPQueue *list,
+	size_t start,
+	void **array,
+	size_t count)
+{
+	MPQueue_cell *cell = NULL;
+	size_t i;
+
+	for (i = 0; i < count; i++) {
+		cell = list->buffer + ((start + i) & list->mask);
+		array[i] = cell->data;
+		MPQUEUE_ORDER ();
+		cell->seq = start + i + list->size;
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	function to push data onto a multi producer que if there is room
+
+	Arguments:
+				list	the que
+				data	the data you wish to store in the que
+
+	returns:
+				0 on success
+				1 if the que is full
+				-1 on error
+
+*******************************************************************************/
+
+int MPQueue_try_push (
+	MPQueue * list,
+	void *data)
+{
+	size_t start;
+
+	if (MPQueue_start (list))
+		return -1;
+
+	if (!MPQueue_claim (list, &list->head, 0, 1, &start))
+		return 1;
+
+	MPQueue_fill (list, start, &data, 1);
+
+	return 0;
+}
+
+/*******************************************************************************
+	function to push data onto a multi producer que, waiting for room
+
+	Arguments:
+				list	the que
+				data	the data you wish to store in the que
+
+	returns:
+				0 on success
+				-1 on error
+
+*******************************************************************************/
+
+int MPQueue_push (
+	MPQueue * list,
+	void *data)
+{
+	int result;
+
+	while ((result = MPQueue_try_push (list, data)) > 0)
+		sched_yield ();
+
+	return result;
+}
+
+/*******************************************************************************
+	function to pull data from a multi producer que if there is any
+
+	Arguments:
+				list	the que
+
+	returns:
+				the data
+				NULL if the que is empty
+
+*******************************************************************************/
+
+void *MPQueue_try_pull (
+	MPQueue * list)
+{
+	void *result = NULL;
+	size_t start;
+
+	if (list->state != 2)
+		return NULL;
+
+	MPQUEUE_ORDER ();
+
+	if (MPQueue_claim (list, &list->tail, 1, 1, &start))
+		MPQueue_empty (list, start, &result, 1);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to pull data from a multi producer que, waiting for some
+
+	Arguments:
+				list	the que
+
+	returns:
+				the data
+
+*******************************************************************************/
+
+void *MPQueue_pull (
+	MPQueue * list)
+{
+	void *result = NULL;
+
+	while (!(result = MPQueue_try_pull (list)))
+		sched_yield ();
+
+	return result;
+}
+
+/*******************************************************************************
+	function to push the data in an array onto a multi producer que
+
+	Arguments:
+				list	the que
+				array	the data you wish to store in the que
+				count	the number of entries in the array
+
+	returns:
+				the number of entries pushed, less than count if the que filled up
+				or on error
+
+*******************************************************************************/
+
+size_t MPQueue_push_n (
+	MPQueue * list,
+	void **array,
+	size_t count)
+{
+	size_t result = 0;
+	size_t start;
+	size_t n;
+
+	if (MPQueue_start (list))
+		return 0;
+
+	while (result < count &&
+				 (n = MPQueue_claim (list, &list->head, 0, count - result, &start))) {
+		MPQueue_fill (list, start, array + result, n);
+		result += n;
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to pull data from a multi producer que into an array
+
+	Arguments:
+				list	the que
+				array	the array to fill
+				count	the number of entries in the array
+
+	returns:
+				the number of entries filled in, less than count if the que ran
+				out
+
+*******************************************************************************/
+
+size_t MPQueue_pull_n (
+	MPQueue * list,
+	void **array,
+	size_t count)
+{
+	size_t result = 0;
+	size_t start;
+	size_t n;
+
+	if (list->state != 2)
+		return 0;
+
+	MPQUEUE_ORDER ();
+
+	while (result < count &&
+				 (n = MPQueue_claim (list, &list->tail, 1, count - result, &start))) {
+		MPQueue_empty (list, start, array + result, n);
+		result += n;
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to count the items in a multi producer que
+
+	Arguments:
+				list	the que
+
+	returns:
+				the number of items in the que
+
+*******************************************************************************/
+
+size_t MPQueue_length (
+	MPQueue * list)
+{
+	size_t tail = list->tail;
+	size_t head = list->head;
+	size_t result = 0;
+
+	if ((long) (head - tail) > 0)
+		result = head - tail;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete all the items in a multi producer que and free its
+	buffer
+
+	Arguments:
+				list		the que
+				function	the function to call to free the data, or NULL
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void MPQueue_delete_all (
+	MPQueue * list,
+	MPQueue_data_free_func function)
+{
+	size_t i;
+
+	if (function && list->buffer) {
+		for (i = list->tail; i != list->head; i++)
+			function (list->buffer[i & list->mask].data);
+	}
+
+	free (list->buffer);
+
+	list->buffer = NULL;
+	list->mask = 0;
+	list->state = 0;
+	list->head = 0;
+	list->tail = 0;
+
+	return;
+}
@@ -96,6 +96,7 @@ MWTree_node *newnode(void) {
     new->children.length = 0;
     new->children.head = NULL;
     new->children.tail = NULL;
+    new->children.pool = NULL;
     new->data = NULL;
   }
 
@@ -0,0 +1,520 @@
+/*******************************************************************************
+	PLList.c
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "../include/PLList.h"
+
+/***** the links after node x, the heads if x is null *****/
+
+#define LINKS(list, x) ((x) ? (x)->link : (list)->head)
+
+/*******************************************************************************
+	slave function to pick the level of a new node, each level up is a quarter
+	as likely as the one below
+*******************************************************************************/
+
+static size_t PLList_random_level (
+	PLList *list)
+{
+	unsigned long r = list->seed & 0xffffffffUL;
+	size_t level = 1;
+
+	/***** xorshift32 *****/
+
+	if (!r)
+		r = 2463534242UL;
+
+	r ^= (r << 13) & 0xffffffffUL;
+	r ^= r >> 17;
+	r ^= (r << 5) & 0xffffffffUL;
+	list->seed = r;
+
+	while (level < PLLIST_MAXLEVEL && !(r & 3)) {
+		level++;
+		r = (r >> 2) | 0x80000000UL;
+	}
+
+	return level;
+}
+
+/*******************************************************************************
+	slave function to find the last link before a position on each level
+
+	Arguments:
+				list		the linked list
+				pos			the position counting from 1 at the head
+				update	set to the last link on each level starting before pos
+				rank		set to the position each of those links starts at, 0 for
+								the heads
+
+	returns:
+				the node at pos - 1
+				NULL if pos is 1
+*******************************************************************************/
+
+static PLList_node *PLList_search (
+	PLList *list,
+	size_t pos,
+	PLList_link **update,
+	size_t *rank)
+{
+	PLList_node *x = NULL;
+	PLList_link *links = NULL;
+	size_t r = 0;
+	size_t i;
+
+	for (i = list->level; i > 0; i--) {
+		links = LINKS (list, x);
+
+		while (links[i - 1].next && r + links[i - 1].width < pos) {
+			r += links[i - 1].width;
+			x = links[i - 1].next;
+			links = x->link;
+		}
+
+		update[i - 1] = links + i - 1;
+		rank[i - 1] = r;
+	}
+
+	return x;
+}
+
+/*******************************************************************************
+	function to get the node at a position in a positional linked list
+
+	Arguments:
+				list	the linked list
+				index	the position, 0 is the head
+
+	returns:
+				the node
+				NULL if index is past the tail
+
+*******************************************************************************/
+
+PLList_node *PLList_get (
+	PLList * list,
+	size_t index)
+{
+	PLList_link *update[PLLIST_MAXLEVEL];
+	size_t rank[PLLIST_MAXLEVEL];
+	PLList_node *result = NULL;
+
+	if (index < list->length) {
+		PLList_search (list, index + 1, update, rank);
+		result = update[0]->next;
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to get the position of a node in a positional linked list
+
+	Arguments:
+				list	the linked list
+				node	the node
+
+	returns:
+				the position of the node, 0 is the head
+
+	notes:
+				following the top link of each node to the end of the list climbs
+				the levels the way a search from the head would, so it takes
+				O(log n) steps
+
+*******************************************************************************/
+
+size_t PLList_index (
+	PLList * list,
+	PLList_node * node)
+{
+	PLList_link *link = NULL;
+	size_t to_end = 0;
+
+	while (node) {
+		link = node->link + node->level - 1;
+		to_end += link->width;
+		node = link->next;
+	}
+
+	return list->length - to_end;
+}
+
+/*******************************************************************************
+	function to add a node at a position in a positional linked list
+
+	Arguments:
+				list	the linked list
+				index	the position the new node will have, 0 prepends, the length
+							appends
+				data	the data you wish to store in the linked list
+
+	returns:
+				the new node
+				NULL on error or if index is past the length
+
+*******************************************************************************/
+
+PLList_node *PLList_insert (
+	PLList * list,
+	size_t index,
+	void *data)
+{
+	PLList_link *update[PLLIST_MAXLEVEL];
+	size_t rank[PLLIST_MAXLEVEL];
+	PLList_node *new = NULL;
+	PLList_node *prev = NULL;
+	size_t level;
+	size_t i;
+
+	if (index > list->length)
+		return NULL;
+
+	level = PLList_random_level (list);
+
+	if (!(new = malloc (offsetof (PLList_node, link) +
+											level * sizeof (PLList_link))))
+		return NULL;
+
+	new->data = data;
+	new->level = level;
+
+	prev = PLList_search (list, index + 1, update, rank);
+
+	/***** new levels start at the heads and span the whole list *****/
+
+	for (; list->level < level; list->level++) {
+		list->head[list->level].next = NULL;
+		list->head[list->level].width = list->length + 1;
+		update[list->level] = list->head + list->level;
+		rank[list->level] = 0;
+	}
+
+	/***** split the links the new node sits under *****/
+
+	for (i = 0; i < level; i++) {
+		new->link[i].next = update[i]->next;
+		new->link[i].width = rank[i] + update[i]->width - index;
+		update[i]->next = new;
+		update[i]->width = index + 1 - rank[i];
+	}
+
+	/***** the links over it just get longer *****/
+
+	for (; i < list->level; i++)
+		update[i]->width++;
+
+	new->prev = prev;
+
+	if (new->link[0].next)
+		new->link[0].next->prev = new;
+	else
+		list->tail = new;
+
+	list->length++;
+
+	return new;
+}
+
+/*******************************************************************************
+	function to add a node to the head of a positional linked list
+
+	Arguments:
+				list	the linked list
+				data	the data you wish to store in the linked list
+
+	returns:
+				the new node
+				NULL on error
+
+*******************************************************************************/
+
+PLList_node *PLList_prepend (
+	PLList * list,
+	void *data)
+{
+	PLList_node *result = NULL;
+
+	result = PLList_insert (list, 0, data);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to add a node to the tail of a positional linked list
+
+	Arguments:
+				list	the linked list
+				data	the data you wish to store in the linked list
+
+	returns:
+				the new node
+				NULL on error
+
+*******************************************************************************/
+
+PLList_node *PLList_append (
+	PLList * list,
+	void *data)
+{
+	PLList_node *result = NULL;
+
+	result = PLList_insert (list, list->length, data);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to add a node after any node in a positional linked list
+
+	Arguments:
+				list	the linked list
+				node	the node you wish to place the new node after
+				data	the data you wish to store in the linked list
+
+	returns:
+				the new node
+				NULL on error
+
+  note:
+        if node is null the new node will be appended to the list
+*******************************************************************************/
+
+PLList_node *PLList_insert_after (
+	PLList * list,
+	PLList_node * node,
+	void *data)
+{
+	PLList_node *result = NULL;
+
+	if (!node)
+		result = PLList_insert (list, list->length, data);
+	else
+		result = PLList_insert (list, PLList_index (list, node) + 1, data);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to add a node before any node in a positional linked list
+
+	Arguments:
+				list	the linked list
+				node	the node you wish to place the new node before
+				data	the data you wish to store in the linked list
+
+	returns:
+				the new node
+				NULL on error
+
+  note:
+        if node is null the new node will be prepended to the list
+*******************************************************************************/
+
+PLList_node *PLList_insert_before (
+	PLList * list,
+	PLList_node * node,
+	void *data)
+{
+	PLList_node *result = NULL;
+
+	if (!node)
+		result = PLList_insert (list, 0, data);
+	else
+		result = PLList_insert (list, PLList_index (list, node), data);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete the node at a position in a positional linked list
+
+	Arguments:
+				list	the linked list
+				index	the position of the node, 0 is the head
+
+	returns:
+				the data the node held
+				NULL if index is past the tail
+
+*******************************************************************************/
+
+void *PLList_delete_index (
+	PLList * list,
+	size_t index)
+{
+	PLList_link *update[PLLIST_MAXLEVEL];
+	size_t rank[PLLIST_MAXLEVEL];
+	PLList_node *node = NULL;
+	void *result = NULL;
+	size_t i;
+
+	if (index >= list->length)
+		return NULL;
+
+	PLList_search (list, index + 1, update, rank);
+	node = update[0]->next;
+	result = node->data;
+
+	/***** join the links the node sat under *****/
+
+	for (i = 0; i < node->level; i++) {
+		update[i]->width += node->link[i].width - 1;
+		update[i]->next = node->link[i].next;
+	}
+
+	/***** the links over it just get shorter *****/
+
+	for (; i < list->level; i++)
+		update[i]->width--;
+
+	if (node->link[0].next)
+		node->link[0].next->prev = node->prev;
+	else
+		list->tail = node->prev;
+
+	/***** drop empty levels *****/
+
+	while (list->level > 0 && !list->head[list->level - 1].next)
+		list->level--;
+
+	free (node);
+	list->length--;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete a node from a positional linked list
+
+	Arguments:
+				list	the linked list
+				node	the node to delete
+
+	returns:
+				the data the node held
+
+*******************************************************************************/
+
+void *PLList_delete (
+	PLList * list,
+	PLList_node * node)
+{
+	void *result = NULL;
+
+	result = PLList_delete_index (list, PLList_index (list, node));
+
+	return result;
+}
+
+/*******************************************************************************
+	function to count the nodes in a positional linked list
+
+	Arguments:
+				list	the linked list
+
+	returns:
+				the number of nodes in the linked list
+
+*******************************************************************************/
+
+size_t PLList_length (
+	PLList * list)
+{
+	size_t result = list->length;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to iterate a positional linked list
+
+	Arguments:
+				list 		the linked list
+				function	the function to pass each node to for processing
+				extra		extra data to pass to/from the proccessing function
+
+	returns:
+				the non null returned from the proccessing function that stops the
+				iteration
+				NULL if the end of the linked list was reached
+
+*******************************************************************************/
+
+void *PLList_iterate (
+	PLList * list,
+	PLList_iterate_func function,
+	void *extra)
+{
+	PLList_node *node = NULL;
+	PLList_node *next = NULL;
+	void *result = NULL;
+
+	for (node = list->head[0].next; node && !result; node = next) {
+		next = node->link[0].next;
+		result = function (list, node, node->data, extra);
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete all the nodes in a positional linked list
+
+	Arguments:
+				list		the linked list
+				function	the function to call to free the data, or NULL
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void PLList_delete_all (
+	PLList * list,
+	PLList_data_free_func function)
+{
+	PLList_node *node = NULL;
+	PLList_node *next = NULL;
+	size_t i;
+
+	for (node = list->head[0].next; node; node = next) {
+		next = node->link[0].next;
+
+		if (function)
+			function (node->data);
+
+		free (node);
+	}
+
+	for (i = 0; i < list->level; i++)
+		list->head[i].next = NULL;
+
+	list->level = 0;
+	list->length = 0;
+	list->tail = NULL;
+
+	return;
+}
@@ -50,11 +50,12 @@ void *QLList_push (
 	QLList *list,
 	void *data)
 {
-	
-	DLList_prepend(
+
+	if (!DLList_prepend(
 				  (DLList *) list,
-				  data);
-	
+				  data))
+		return NULL;
+
 	return data;
 }
 
@@ -225,3 +226,98 @@ QLList_node *QLList_push_list_copy (
   
 	return result;
 }
+
+/*******************************************************************************
+	function to push the data in an array onto a que
+
+	Arguments:
+				list	the linked list
+				array	the data you wish to store in the linked list
+				count	the number of entries in the array
+
+	returns:
+				0 on success
+				1 on error, nothing is pushed
+
+	notes:
+				the same as pushing each entry in turn, array[0] is pulled first
+
+*******************************************************************************/
+
+int QLList_push_array (
+	QLList * list,
+	void **array,
+	size_t count)
+{
+	int result;
+
+	result = DLList_prepend_array ((DLList *) list, array, count);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to copy the data in a que to an array
+
+	Arguments:
+				list	the linked list
+				array	the array to fill, it must have room for the length of the
+							list
+
+	returns:
+				the number of entries filled in
+
+	notes:
+				the array is filled from the tail to the head, the order the data
+				would be pulled in
+
+*******************************************************************************/
+
+size_t QLList_to_array (
+	QLList * list,
+	void **array)
+{
+	QLList_node *node = list->tail;
+	size_t i;
+
+	for (i = 0; i < list->length; i++, node = node->prev)
+		array[i] = node->data;
+
+	return i;
+}
+
+/*******************************************************************************
+	function to copy another list to the head of a que, all or nothing
+
+	Arguments:
+				dest		the linked list you want to copy the src to
+				src			the linked list you want to copy to the dest
+				copy_func	function to copy the data held in each node
+				free_func	function to free the copies made if a later one fails,
+										or NULL
+				arena		the arena to pass to copy_func, or NULL
+
+	returns:
+				0 on success
+				1 on error, nothing is added
+
+*******************************************************************************/
+
+int QLList_push_list_copy_arena (
+	QLList * dest,
+	QLList * src,
+	QLList_data_arena_copy_func copy_func,
+	QLList_data_free_func free_func,
+	LLArena * arena)
+{
+	int result;
+
+	result = DLList_prepend_list_copy_arena (
+				(DLList *) dest,
+				(DLList *) src,
+				(DLList_data_arena_copy_func) copy_func,
+				(DLList_data_free_func) free_func,
+				arena);
+
+	return result;
+}
@@ -0,0 +1,348 @@
+/*******************************************************************************
+	SPQueue.c
+
+	single producer single consumer fifo
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "../include/SPQueue.h"
+
+/***** the slots must be written before the index that hands them over *****/
+
+#if defined (__x86_64__) || defined (__i386__)
+
+/***** x86 keeps stores in order and loads in order, only gcc must not move them *****/
+
+#define SPQUEUE_ORDER() __asm__ __volatile__ ("" : : : "memory")
+
+#else
+#define SPQUEUE_ORDER() __sync_synchronize ()
+#endif
+
+/*******************************************************************************
+	slave function to allocate the buffer on the first push
+
+	returns:
+				0 on success
+				-1 on error
+*******************************************************************************/
+
+static int SPQueue_start (
+	SPQueue *list)
+{
+	size_t size = 1;
+
+	if (list->buffer)
+		return 0;
+
+	if (!list->size)
+		list->size = SPQUEUE_SIZE;
+
+	/***** too big to round up to a power of 2 and allocate *****/
+
+	if (list->size > SIZE_MAX / sizeof (void *) / 2 + 1)
+		return -1;
+
+	while (size < list->size)
+		size <<= 1;
+
+	if (!(list->buffer = malloc (size * sizeof (void *))))
+		return -1;
+
+	list->size = size;
+	list->mask = size - 1;
+
+	return 0;
+}
+
+/*******************************************************************************
+	slave function to get the free slots, only reading the consumer's index
+	when the last one read is not enough
+*******************************************************************************/
+
+static size_t SPQueue_room (
+	SPQueue *list,
+	size_t want)
+{
+	size_t result = list->size - (list->head - list->tail_seen);
+
+	if (result < want) {
+		list->tail_seen = list->tail;
+		SPQUEUE_ORDER ();
+		result = list->size - (list->head - list->tail_seen);
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	slave function to get the full slots, only reading the producer's index
+	when the last one read is not enough
+*******************************************************************************/
+
+static size_t SPQueue_used (
+	SPQueue *list,
+	size_t want)
+{
+	size_t result = list->head_seen - list->tail;
+
+	if (result < want) {
+		list->head_seen = list->head;
+		SPQUEUE_ORDER ();
+		result = list->head_seen - list->tail;
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to push data onto a single producer que
+
+	Arguments:
+				list	the que
+				data	the data you wish to store in the que
+
+	returns:
+				0 on success
+				1 if the que is full
+				-1 on error
+
+*******************************************************************************/
+
+int SPQueue_push (
+	SPQueue * list,
+	void *data)
+{
+	size_t head = list->head;
+
+	if (SPQueue_start (list))
+		return -1;
+
+	if (!SPQueue_room (list, 1))
+		return 1;
+
+	list->buffer[head & list->mask] = data;
+	SPQUEUE_ORDER ();
+	list->head = head + 1;
+
+	return 0;
+}
+
+/*******************************************************************************
+	function to pull data from a single producer que
+
+	Arguments:
+				list	the que
+
+	returns:
+				the data
+				NULL if the que is empty
+
+*******************************************************************************/
+
+void *SPQueue_pull (
+	SPQueue * list)
+{
+	size_t tail = list->tail;
+	void *result = NULL;
+
+	if (!SPQueue_used (list, 1))
+		return NULL;
+
+	result = list->buffer[tail & list->mask];
+	SPQUEUE_ORDER ();
+	list->tail = tail + 1;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to push the data in an array onto a single producer que
+
+	Arguments:
+				list	the que
+				array	the data you wish to store in the que
+				count	the number of entries in the array
+
+	returns:
+				the number of entries pushed, less than count if the que filled up
+				or on error
+
+	notes:
+				the slots are copied in up to 2 runs, one to the end of the buffer
+				and one from the start, then the head is moved once
+
+*******************************************************************************/
+
+size_t SPQueue_push_n (
+	SPQueue * list,
+	void **array,
+	size_t count)
+{
+	size_t head = list->head;
+	size_t room;
+	size_t first;
+
+	if (!count || SPQueue_start (list))
+		return 0;
+
+	if ((room = SPQueue_room (list, count)) < count)
+		count = room;
+
+	first = list->size - (head & list->mask);
+
+	if (first > count)
+		first = count;
+
+	memcpy (list->buffer + (head & list->mask), array, first * sizeof (void *));
+	memcpy (list->buffer, array + first, (count - first) * sizeof (void *));
+
+	SPQUEUE_ORDER ();
+	list->head = head + count;
+
+	return count;
+}
+
+/*******************************************************************************
+	function to pull data from a single producer que into an array
+
+	Arguments:
+				list	the que
+				array	the array to fill
+				count	the number of entries in the array
+
+	returns:
+				the number of entries filled in, less than count if the que ran
+				out
+
+*******************************************************************************/
+
+size_t SPQueue_pull_n (
+	SPQueue * list,
+	void **array,
+	size_t count)
+{
+	size_t tail = list->tail;
+	size_t used;
+	size_t first;
+
+	if ((used = SPQueue_used (list, count)) < count)
+		count = used;
+
+	if (!count)
+		return 0;
+
+	first = list->size - (tail & list->mask);
+
+	if (first > count)
+		first = count;
+
+	memcpy (array, list->buffer + (tail & list->mask), first * sizeof (void *));
+	memcpy (array + first, list->buffer, (count - first) * sizeof (void *));
+
+	SPQUEUE_ORDER ();
+	list->tail = tail + count;
+
+	return count;
+}
+
+/*******************************************************************************
+	function to read the data that will be pulled next without pulling it
+
+	Arguments:
+				list	the que
+
+	returns:
+				the data
+				NULL if the que is empty
+
+*******************************************************************************/
+
+void *SPQueue_read (
+	SPQueue * list)
+{
+	void *result = NULL;
+
+	if (SPQueue_used (list, 1))
+		result = list->buffer[list->tail & list->mask];
+
+	return result;
+}
+
+/*******************************************************************************
+	function to count the items in a single producer que
+
+	Arguments:
+				list	the que
+
+	returns:
+				the number of items in the que
+
+*******************************************************************************/
+
+size_t SPQueue_length (
+	SPQueue * list)
+{
+	size_t tail = list->tail;
+	size_t result = list->head - tail;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete all the items in a single producer que and free its
+	buffer
+
+	Arguments:
+				list		the que
+				function	the function to call to free the data, or NULL
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void SPQueue_delete_all (
+	SPQueue * list,
+	SPQueue_data_free_func function)
+{
+	size_t i;
+
+	if (function) {
+		for (i = list->tail; i != list->head; i++)
+			function (list->buffer[i & list->mask]);
+	}
+
+	free (list->buffer);
+
+	list->buffer = NULL;
+	list->mask = 0;
+	list->head = 0;
+	list->tail_seen = 0;
+	list->tail = 0;
+	list->head_seen = 0;
+
+	return;
+}
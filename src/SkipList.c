@@ -0,0 +1,421 @@
+/*******************************************************************************
+	SkipList.c
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "../include/SkipList.h"
+
+/***** the links on level i after node x, the heads if x is null *****/
+
+#define LINKS(list, x) ((x) ? (x)->next : (list)->head)
+
+/*******************************************************************************
+	slave function to pick the level of a new node, each level up is a quarter
+	as likely as the one below
+*******************************************************************************/
+
+static size_t SkipList_random_level (
+	SkipList *list)
+{
+	unsigned long r = list->seed & 0xffffffffUL;
+	size_t level = 1;
+
+	/***** xorshift32 *****/
+
+	if (!r)
+		r = 2463534242UL;
+
+	r ^= (r << 13) & 0xffffffffUL;
+	r ^= r >> 17;
+	r ^= (r << 5) & 0xffffffffUL;
+	list->seed = r;
+
+	while (level < SKIPLIST_MAXLEVEL && !(r & 3)) {
+		level++;
+		r = (r >> 2) | 0x80000000UL;
+	}
+
+	return level;
+}
+
+/*******************************************************************************
+	slave function to find the links that lead to the first node not less
+	than data on each level
+
+	Arguments:
+				list		the list
+				data		the data to look for
+				update	set to the link on each level that points to the node
+
+	returns:
+				the first node not less than data
+				NULL if there is none
+*******************************************************************************/
+
+static SkipList_node *SkipList_search (
+	SkipList *list,
+	void *data,
+	SkipList_node ***update)
+{
+	SkipList_node *x = NULL;
+	SkipList_node **links = NULL;
+	size_t i;
+
+	for (i = list->level; i > 0; i--) {
+		links = LINKS (list, x);
+
+		while (links[i - 1] && list->cmp (links[i - 1]->data, data) < 0) {
+			x = links[i - 1];
+			links = x->next;
+		}
+
+		if (update)
+			update[i - 1] = links + i - 1;
+	}
+
+	return links ? links[0] : NULL;
+}
+
+/*******************************************************************************
+	function to find a node in a skip list
+
+	Arguments:
+				list	the list to find the node in
+				data	the data to look for
+
+	returns:
+				the first node that holds data equal to data
+				null if the data is not found
+
+	notes:
+				the data passed to this function to look for is only bound by the
+				data compare function
+*******************************************************************************/
+
+SkipList_node *SkipList_find (
+	SkipList *list,
+	void *data)
+{
+	SkipList_node *result = NULL;
+
+	result = SkipList_search (list, data, NULL);
+
+	if (result && list->cmp (result->data, data))
+		result = NULL;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to find the first node in a skip list not less than some data
+
+	Arguments:
+				list	the list to search
+				data	the data to look for
+
+	returns:
+				the first node that holds data greater than or equal to data
+				null if all the data in the list is less than data
+*******************************************************************************/
+
+SkipList_node *SkipList_lower_bound (
+	SkipList *list,
+	void *data)
+{
+	SkipList_node *result = NULL;
+
+	result = SkipList_search (list, data, NULL);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to add a node to a skip list
+
+	Arguments:
+				list	the list to add the node to
+				data	the data the node is to hold
+
+	returns:
+				the new node
+				NULL if malloc fails
+
+	notes:
+				data equal to data already in the list goes after it
+*******************************************************************************/
+
+SkipList_node *SkipList_insert (
+	SkipList *list,
+	void *data)
+{
+	SkipList_node **update[SKIPLIST_MAXLEVEL];
+	SkipList_node *new = NULL;
+	SkipList_node *x = NULL;
+	SkipList_node **links = NULL;
+	size_t level = SkipList_random_level (list);
+	size_t i;
+
+	if (!(new = malloc (offsetof (SkipList_node, next) +
+											level * sizeof (SkipList_node *))))
+		return NULL;
+
+	new->data = data;
+	new->level = level;
+
+	/***** find the links, stepping past equal data *****/
+
+	for (i = list->level; i > 0; i--) {
+		links = LINKS (list, x);
+
+		while (links[i - 1] && list->cmp (links[i - 1]->data, data) <= 0) {
+			x = links[i - 1];
+			links = x->next;
+		}
+
+		update[i - 1] = links + i - 1;
+	}
+
+	/***** new levels start at the heads *****/
+
+	for (; list->level < level; list->level++)
+		update[list->level] = list->head + list->level;
+
+	for (i = 0; i < level; i++) {
+		new->next[i] = *update[i];
+		*update[i] = new;
+	}
+
+	list->length++;
+
+	return new;
+}
+
+/*******************************************************************************
+	funtion to delete a node from a skip list
+
+	Arguments:
+				list	the list to delete the node from
+				node	the node to delete
+
+	returns:
+				the data the node held
+*******************************************************************************/
+
+void *SkipList_delete (
+	SkipList *list,
+	SkipList_node *node)
+{
+	SkipList_node *x = NULL;
+	SkipList_node **links = NULL;
+	void *result = node->data;
+	size_t i;
+
+	for (i = list->level; i > 0; i--) {
+		links = LINKS (list, x);
+
+		/***** above the node skip the less, on its levels walk up to it *****/
+
+		if (i > node->level) {
+			while (links[i - 1] && list->cmp (links[i - 1]->data, result) < 0) {
+				x = links[i - 1];
+				links = x->next;
+			}
+		}
+
+		else {
+			while (links[i - 1] != node) {
+				x = links[i - 1];
+				links = x->next;
+			}
+
+			links[i - 1] = node->next[i - 1];
+		}
+	}
+
+	/***** drop empty levels *****/
+
+	while (list->level > 0 && !list->head[list->level - 1])
+		list->level--;
+
+	free (node);
+	list->length--;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to count the nodes in a skip list
+
+	Arguments:
+				list	the list
+
+	returns:
+				the number of nodes in the list
+
+*******************************************************************************/
+
+size_t SkipList_length (
+	SkipList *list)
+{
+	size_t result = list->length;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to iterate a skip list in order
+
+	Arguments:
+				list 		the list
+				function	the function to pass each node to for processing
+				extra		extra data to pass to/from the proccessing function
+
+	returns:
+				the non null returned from the proccessing function that stops the
+				iteration
+				NULL if the end of the list was reached
+*******************************************************************************/
+
+void *SkipList_iterate (
+	SkipList *list,
+	SkipList_iterate_func function,
+	void *extra)
+{
+	void *result = NULL;
+
+	result = SkipList_range (list, NULL, NULL, function, extra);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to iterate the nodes of a skip list in a range in order
+
+	Arguments:
+				list 		the list
+				lo			the lowest data to pass, or NULL to start at the first node
+				hi			the data to stop before, or NULL to run to the last node
+				function	the function to pass each node to for processing
+				extra		extra data to pass to/from the proccessing function
+
+	returns:
+				the non null returned from the proccessing function that stops the
+				iteration
+				NULL if the end of the range was reached
+*******************************************************************************/
+
+void *SkipList_range (
+	SkipList *list,
+	void *lo,
+	void *hi,
+	SkipList_iterate_func function,
+	void *extra)
+{
+	SkipList_node *node = NULL;
+	SkipList_node *next = NULL;
+	void *result = NULL;
+
+	if (lo)
+		node = SkipList_search (list, lo, NULL);
+	else
+		node = list->head[0];
+
+	for (; node && !result; node = next) {
+		next = node->next[0];
+
+		if (hi && list->cmp (node->data, hi) >= 0)
+			break;
+
+		result = function (list, node, node->data, extra);
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete all the nodes in a skip list
+
+	Arguments:
+				list	the list to delete all the nodes in
+
+	returns:
+				nothing
+*******************************************************************************/
+
+void SkipList_delete_all (
+	SkipList *list)
+{
+	SkipList_node *node = NULL;
+	SkipList_node *next = NULL;
+	size_t i;
+
+	for (node = list->head[0]; node; node = next) {
+		next = node->next[0];
+
+		if (list->free)
+			list->free (node->data);
+
+		free (node);
+	}
+
+	for (i = 0; i < list->level; i++)
+		list->head[i] = NULL;
+
+	list->level = 0;
+	list->length = 0;
+
+	return;
+}
+
+/*******************************************************************************
+	function to copy a skip list into another skip list
+
+	Arguments:
+				dest	the list to copy the nodes to
+				src		the list to copy the nodes from
+
+	returns:
+				null on success
+				the src node we were trying to copy when malloc or src->copy failed
+*******************************************************************************/
+
+SkipList_node *SkipList_copy (
+	SkipList *dest,
+	SkipList *src)
+{
+	SkipList_node *node = NULL;
+	void *data = NULL;
+
+	for (node = src->head[0]; node; node = node->next[0]) {
+		if (!src->copy (&data, node->data))
+			break;
+
+		if (!SkipList_insert (dest, data)) {
+			if (dest->free)
+				dest->free (data);
+			break;
+		}
+	}
+
+	return node;
+}
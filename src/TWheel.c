@@ -0,0 +1,400 @@
+/*******************************************************************************
+	TWheel.c
+
+	hierarchical timing wheel
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/LLPool.h"
+#include "../include/CLList.h"
+#include "../include/TWheel.h"
+
+/***** the number of ticks the wheel covers *****/
+
+#define TWHEEL_SPAN (1UL << (TWHEEL_BITS * TWHEEL_LEVELS))
+
+/***** the slot index of a tick in a level *****/
+
+#define INDEX(tick, level) \
+	((size_t) ((tick) >> (TWHEEL_BITS * (level))) & (TWHEEL_SLOTS - 1))
+
+/*******************************************************************************
+	slave function to put a timer in the slot for its tick, the lowest level
+	whose slots are narrow enough to hold the time left
+
+	returns:
+				0 on success
+				1 on error
+*******************************************************************************/
+
+static int TWheel_place (
+	TWheel *wheel,
+	TWheel_timer *timer)
+{
+	unsigned long expire = timer->expire;
+	unsigned long delta;
+	int level;
+
+	/***** late timers go in the next slot to fire *****/
+
+	if (expire < wheel->tick)
+		expire = wheel->tick;
+
+	delta = expire - wheel->tick;
+
+	/***** too far out? park it at the far end, it is placed again later *****/
+
+	if (delta >= TWHEEL_SPAN) {
+		delta = TWHEEL_SPAN - 1;
+		expire = wheel->tick + delta;
+	}
+
+	for (level = 0;
+			 level < TWHEEL_LEVELS - 1 && delta >> (TWHEEL_BITS * (level + 1));
+			 level++) {
+	}
+
+	timer->slot = &wheel->slot[level][INDEX (expire, level)];
+	timer->slot->pool = &wheel->pool;
+	timer->level = level;
+
+	if (!(timer->node = CLList_append (timer->slot, timer)))
+		return 1;
+
+	wheel->count[level]++;
+
+	return 0;
+}
+
+/*******************************************************************************
+	slave function to take a timer out of its slot
+
+	returns:
+				nothing
+*******************************************************************************/
+
+static void TWheel_remove (
+	TWheel *wheel,
+	TWheel_timer *timer)
+{
+
+	CLList_delete (timer->slot, timer->node);
+
+	if (timer->level >= 0)
+		wheel->count[timer->level]--;
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to move the timers in the current slot of a level down
+	to the levels below
+
+	returns:
+				nothing
+
+	notes:
+				each timer gives its node back to the pool before it is placed
+				again, so placing it takes the same node back and can not fail
+*******************************************************************************/
+
+static void TWheel_cascade (
+	TWheel *wheel,
+	int level)
+{
+	CLList *slot = &wheel->slot[level][INDEX (wheel->tick, level)];
+	CLList pending = *slot;
+	TWheel_timer *timer = NULL;
+
+	memset (slot, 0, sizeof (CLList));
+	wheel->count[level] -= pending.length;
+
+	while (pending.length) {
+		timer = pending.head->data;
+		CLList_delete (&pending, pending.head);
+		TWheel_place (wheel, timer);
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	function to schedule a timer in a timing wheel
+
+	Arguments:
+				wheel		the wheel
+				expire	the tick the timer fires at
+				data		the data to pass to the expire function
+
+	returns:
+				the timer, it stays valid until it fires or is canceled
+				NULL on error
+
+*******************************************************************************/
+
+TWheel_timer *TWheel_schedule (
+	TWheel * wheel,
+	unsigned long expire,
+	void *data)
+{
+	TWheel_timer *result = NULL;
+
+	if (!(result = LLPool_alloc (&wheel->timers, sizeof (TWheel_timer))))
+		return NULL;
+
+	result->expire = expire;
+	result->data = data;
+
+	if (TWheel_place (wheel, result)) {
+		LLPool_free (&wheel->timers, result);
+		return NULL;
+	}
+
+	wheel->length++;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to move a timer in a timing wheel to a new tick
+
+	Arguments:
+				wheel		the wheel
+				timer		the timer
+				expire	the new tick the timer fires at
+
+	returns:
+				0 on success
+				1 on error, the timer is canceled
+
+*******************************************************************************/
+
+int TWheel_reschedule (
+	TWheel * wheel,
+	TWheel_timer * timer,
+	unsigned long expire)
+{
+
+	TWheel_remove (wheel, timer);
+	timer->expire = expire;
+
+	if (TWheel_place (wheel, timer)) {
+		LLPool_free (&wheel->timers, timer);
+		wheel->length--;
+		return 1;
+	}
+
+	return 0;
+}
+
+/*******************************************************************************
+	function to cancel a timer in a timing wheel
+
+	Arguments:
+				wheel	the wheel
+				timer	the timer
+
+	returns:
+				the data the timer was scheduled with
+
+*******************************************************************************/
+
+void *TWheel_cancel (
+	TWheel * wheel,
+	TWheel_timer * timer)
+{
+	void *result = timer->data;
+
+	TWheel_remove (wheel, timer);
+	LLPool_free (&wheel->timers, timer);
+	wheel->length--;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to turn a timing wheel up to a tick and fire every timer that
+	expires by then
+
+	Arguments:
+				wheel		the wheel
+				now			the tick to turn the wheel to
+				function	the function to call for each timer that fires
+				extra		extra data to pass to the function
+
+	returns:
+				the number of timers fired
+
+	notes:
+				each tick only looks at one slot of level 0, the levels above are
+				only touched when the level below wraps, and while the low levels
+				are empty the wheel jumps to the next tick that cascades into
+				them, so the work is the number of timers fired and cascaded and
+				not the number of ticks
+
+				the due slot is taken out of the wheel and the tick moved on
+				before any timer fires, so timers the function schedules for
+				now go in the next slot and not in the list being fired
+
+*******************************************************************************/
+
+size_t TWheel_advance (
+	TWheel * wheel,
+	unsigned long now,
+	TWheel_expire_func function,
+	void *extra)
+{
+	CLList *slot = NULL;
+	CLList pending;
+	CLList_node *node = NULL;
+	TWheel_timer *timer = NULL;
+	void *data = NULL;
+	unsigned long span;
+	size_t result = 0;
+	size_t i;
+	int level;
+
+	while (wheel->tick <= now) {
+
+		/***** nothing to fire? jump straight there *****/
+
+		if (!wheel->length) {
+			wheel->tick = now + 1;
+			break;
+		}
+
+		/***** low levels empty? skip to where the next level cascades *****/
+
+		for (level = 0; !wheel->count[level]; level++) {
+		}
+
+		span = 1UL << (TWHEEL_BITS * level);
+
+		if (level && wheel->tick & (span - 1)) {
+			if ((wheel->tick | (span - 1)) >= now) {
+				wheel->tick = now + 1;
+				break;
+			}
+
+			wheel->tick = (wheel->tick | (span - 1)) + 1;
+		}
+
+		/***** level 0 wrapped? pull the next slot of each level down *****/
+
+		for (level = 1; level < TWHEEL_LEVELS && !INDEX (wheel->tick, level - 1);
+				 level++)
+			TWheel_cascade (wheel, level);
+
+		slot = &wheel->slot[0][INDEX (wheel->tick, 0)];
+		pending = *slot;
+		memset (slot, 0, sizeof (CLList));
+		wheel->count[0] -= pending.length;
+		wheel->tick++;
+
+		/***** a canceled timer must come out of the pending list *****/
+
+		for (i = 0, node = pending.head; i < pending.length; i++, node = node->next) {
+			((TWheel_timer *) node->data)->slot = &pending;
+			((TWheel_timer *) node->data)->level = -1;
+		}
+
+		while (pending.length) {
+			timer = pending.head->data;
+			CLList_delete (&pending, pending.head);
+
+			data = timer->data;
+			LLPool_free (&wheel->timers, timer);
+			wheel->length--;
+			result++;
+
+			function (wheel, data, extra);
+		}
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to count the timers in a timing wheel
+
+	Arguments:
+				wheel	the wheel
+
+	returns:
+				the number of timers in the wheel
+
+*******************************************************************************/
+
+size_t TWheel_length (
+	TWheel * wheel)
+{
+	size_t result = wheel->length;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to cancel all the timers in a timing wheel and free its memory
+
+	Arguments:
+				wheel		the wheel
+				function	the function to call to free the data, or NULL
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void TWheel_delete_all (
+	TWheel * wheel,
+	TWheel_data_free_func function)
+{
+	CLList *slot = NULL;
+	TWheel_timer *timer = NULL;
+	int level;
+	int i;
+
+	for (level = 0; level < TWHEEL_LEVELS; level++) {
+		for (i = 0; i < TWHEEL_SLOTS; i++) {
+			slot = &wheel->slot[level][i];
+
+			while (slot->length) {
+				timer = slot->head->data;
+				CLList_delete (slot, slot->head);
+
+				if (function)
+					function (timer->data);
+			}
+
+			memset (slot, 0, sizeof (CLList));
+		}
+	}
+
+	LLPool_delete_all (&wheel->pool);
+	LLPool_delete_all (&wheel->timers);
+	memset (wheel->count, 0, sizeof (wheel->count));
+	wheel->length = 0;
+
+	return;
+}
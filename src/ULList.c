@@ -0,0 +1,680 @@
+/*******************************************************************************
+	ULList.c
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/ULList.h"
+
+/*******************************************************************************
+	slave function to allocate an empty node and link it in after a node
+
+	if node is null the new node becomes the head
+*******************************************************************************/
+
+static ULList_node *ULList_new_node (
+	ULList *list,
+	ULList_node *node)
+{
+	ULList_node *new = NULL;
+
+	if ((new = LLPool_alloc (list->pool, sizeof (ULList_node)))) {
+		new->used = 0;
+		new->prev = node;
+
+		/***** new head? *****/
+
+		if (!node) {
+			new->next = list->head;
+			list->head = new;
+		}
+		else {
+			new->next = node->next;
+			node->next = new;
+		}
+
+		/***** new tail? *****/
+
+		if (!new->next)
+			list->tail = new;
+		else
+			new->next->prev = new;
+	}
+
+	return new;
+}
+
+/*******************************************************************************
+	slave function to unlink and free an empty node
+*******************************************************************************/
+
+static void ULList_free_node (
+	ULList *list,
+	ULList_node *node)
+{
+
+	if (node->prev)
+		node->prev->next = node->next;
+	else
+		list->head = node->next;
+
+	if (node->next)
+		node->next->prev = node->prev;
+	else
+		list->tail = node->prev;
+
+	LLPool_free (list->pool, node);
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to insert data into a node at a position, the node is split
+	in half if its full, newindex is set to where the data ended up
+*******************************************************************************/
+
+static ULList_node *ULList_insert_at (
+	ULList *list,
+	ULList_node *node,
+	size_t pos,
+	void *data,
+	size_t *newindex)
+{
+	ULList_node *new = NULL;
+	size_t half = ULLIST_NODESIZE / 2;
+
+	/***** full node? move the top half to a new node *****/
+
+	if (node->used == ULLIST_NODESIZE) {
+		if (!(new = ULList_new_node (list, node)))
+			return NULL;
+
+		memcpy (new->data, node->data + half,
+						(ULLIST_NODESIZE - half) * sizeof (void *));
+		new->used = ULLIST_NODESIZE - half;
+		node->used = half;
+
+		if (pos > half) {
+			node = new;
+			pos -= half;
+		}
+	}
+
+	memmove (node->data + pos + 1, node->data + pos,
+					 (node->used - pos) * sizeof (void *));
+	node->data[pos] = data;
+	node->used++;
+	list->length++;
+
+	if (newindex)
+		*newindex = pos;
+
+	return node;
+}
+
+/*******************************************************************************
+	function to add data to the head of an unrolled linked list
+
+	Arguments:
+				list	the linked list
+				data	the data you wish to store in the linked list
+
+	returns:
+				the node that holds the data, the data is at index 0
+				NULL on error
+
+*******************************************************************************/
+
+ULList_node *ULList_prepend (
+	ULList *list,
+	void *data)
+{
+	ULList_node *node = list->head;
+
+	/***** no room in the head? start a new head *****/
+
+	if (!node || node->used == ULLIST_NODESIZE) {
+		if (!(node = ULList_new_node (list, NULL)))
+			return NULL;
+	}
+
+	return ULList_insert_at (list, node, 0, data, NULL);
+}
+
+/*******************************************************************************
+	function to add data to the tail of an unrolled linked list
+
+	Arguments:
+				list	the linked list
+				data	the data you wish to store in the linked list
+
+	returns:
+				the node that holds the data, the data is at index used - 1
+				NULL on error
+
+*******************************************************************************/
+
+ULList_node *ULList_append (
+	ULList *list,
+	void *data)
+{
+	ULList_node *node = list->tail;
+
+	/***** no room in the tail? start a new tail *****/
+
+	if (!node || node->used == ULLIST_NODESIZE) {
+		if (!(node = ULList_new_node (list, list->tail)))
+			return NULL;
+	}
+
+	node->data[node->used++] = data;
+	list->length++;
+
+	return node;
+}
+
+/*******************************************************************************
+	function to add data after any data in an unrolled linked list
+
+	Arguments:
+				list	the linked list
+				node	the node holding the data you wish to place the new data after
+				index	the index of that data in the node
+				data	the data you wish to store in the linked list
+				newindex	set to the index of the new data in the node, or NULL
+
+	returns:
+				the node that holds the new data
+				NULL on error
+
+  note:
+        if node is null or the list is empty the data will be appended to
+        the list
+        a full node is split in half, so the new data may be in a new node
+        at another index, newindex says where it is
+*******************************************************************************/
+
+ULList_node *ULList_insert_after (
+	ULList *list,
+	ULList_node *node,
+	size_t index,
+	void *data,
+	size_t *newindex)
+{
+	ULList_node *result = NULL;
+
+	if (!node || !list->head) {
+		if ((result = ULList_append (list, data)) && newindex)
+			*newindex = result->used - 1;
+	}
+
+	else
+		result = ULList_insert_at (list, node, index + 1, data, newindex);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to add data before any data in an unrolled linked list
+
+	Arguments:
+				list	the linked list
+				node	the node holding the data you wish to place the new data before
+				index	the index of that data in the node
+				data	the data you wish to store in the linked list
+				newindex	set to the index of the new data in the node, or NULL
+
+	returns:
+				the node that holds the new data
+				NULL on error
+
+  note:
+        if node is null or the list is empty the data will be prepended to
+        the list
+        a full node is split in half, so the new data may be in a new node
+        at another index, newindex says where it is
+*******************************************************************************/
+
+ULList_node *ULList_insert_before (
+	ULList *list,
+	ULList_node *node,
+	size_t index,
+	void *data,
+	size_t *newindex)
+{
+	ULList_node *result = NULL;
+
+	if (!node || !list->head) {
+		if ((result = ULList_prepend (list, data)) && newindex)
+			*newindex = 0;
+	}
+
+	else
+		result = ULList_insert_at (list, node, index, data, newindex);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete data from an unrolled linked list
+
+	Arguments:
+				list	the linked list
+				node	the node holding the data you wish to delete
+				index	the index of the data in the node
+
+	returns:
+				the data
+
+*******************************************************************************/
+
+void *ULList_delete (
+	ULList *list,
+	ULList_node *node,
+	size_t index)
+{
+	void *result = node->data[index];
+	ULList_node *next = node->next;
+
+	node->used--;
+	memmove (node->data + index, node->data + index + 1,
+					 (node->used - index) * sizeof (void *));
+	list->length--;
+
+	/***** empty node? *****/
+
+	if (!node->used)
+		ULList_free_node (list, node);
+
+	/***** mostly empty node? pull the next node in if it fits *****/
+
+	else if (node->used < ULLIST_NODESIZE / 4 && next &&
+					 node->used + next->used <= ULLIST_NODESIZE) {
+		memcpy (node->data + node->used, next->data,
+						next->used * sizeof (void *));
+		node->used += next->used;
+		ULList_free_node (list, next);
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to count the data in an unrolled linked list
+
+	Arguments:
+				list	the linked list
+
+	returns:
+				the number of data pointers in the linked list
+
+*******************************************************************************/
+
+size_t ULList_length (
+	ULList *list)
+{
+	size_t result = list->length;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to iterate an unrolled linked list
+
+	Arguments:
+				list 		the linked list
+				function	the function to pass each data to for processing
+				extra		extra data to pass to/from the proccessing function
+
+	return:
+			the non null returned from the proccessing function that stops the
+			iteration
+			NULL if the end of the linked list was reached
+
+  note:
+        the proccessing function must not insert into or delete from the list
+
+*******************************************************************************/
+
+void *ULList_iterate (
+	ULList *list,
+	ULList_iterate_func function,
+	void *extra)
+{
+	ULList_node *node = NULL;
+	size_t i;
+	void *result = NULL;
+
+	for (node = list->head; node && !result; node = node->next) {
+		for (i = 0; i < node->used && !result; i++)
+			result = function (list, node, i, node->data[i], extra);
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete all the nodes in an unrolled linked list
+
+	Arguments:
+				list		the linked list
+				function	the function to call to free the data
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void ULList_delete_all (
+	ULList *list,
+	ULList_data_free_func function)
+{
+	ULList_node *node = NULL;
+	ULList_node *next = NULL;
+	size_t i;
+
+	for (node = list->head; node; node = next) {
+		next = node->next;
+
+		if (function) {
+			for (i = 0; i < node->used; i++)
+				function (node->data[i]);
+		}
+
+		LLPool_free (list->pool, node);
+	}
+
+	list->head = NULL;
+	list->tail = NULL;
+	list->length = 0;
+
+	/***** was that the last node the pool handed out? release its slabs *****/
+
+	if (list->pool && !list->pool->used)
+		LLPool_delete_all (list->pool);
+
+	return;
+}
+
+/*******************************************************************************
+	function to move another unrolled linked list to the head of an unrolled
+	linked list
+
+	Arguments:
+				dest	the linked list you want to move the src to
+				src		the linked list you want to move to the dest
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void ULList_prepend_list (
+	ULList *dest,
+	ULList *src)
+{
+
+	/***** is src an empty list *****/
+
+	if (!src->head) {
+	}
+
+	/***** is dest an empty list *****/
+
+	else if (!dest->head) {
+		dest->head = src->head;
+		dest->tail = src->tail;
+	}
+
+	else {
+		dest->head->prev = src->tail;
+		src->tail->next = dest->head;
+		dest->head = src->head;
+	}
+
+	dest->length += src->length;
+	src->head = NULL;
+	src->tail = NULL;
+	src->length = 0;
+
+	return;
+}
+
+/*******************************************************************************
+	function to move another unrolled linked list to the tail of an unrolled
+	linked list
+
+	Arguments:
+				dest	the linked list you want to move the src to
+				src		the linked list you want to move to the dest
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void ULList_append_list (
+	ULList *dest,
+	ULList *src)
+{
+
+	/***** is src an empty list *****/
+
+	if (!src->head) {
+	}
+
+	/***** is dest an empty list *****/
+
+	else if (!dest->head) {
+		dest->head = src->head;
+		dest->tail = src->tail;
+	}
+
+	else {
+		dest->tail->next = src->head;
+		src->head->prev = dest->tail;
+		dest->tail = src->tail;
+	}
+
+	dest->length += src->length;
+	src->head = NULL;
+	src->tail = NULL;
+	src->length = 0;
+
+	return;
+}
+
+/*******************************************************************************
+	function to move another unrolled linked list to the middle of an unrolled
+	linked list, after a particular node
+
+	Arguments:
+				dest	the linked list you want to move the src to
+				src		the linked list you want to move to the dest
+				node	the node you wish to insert src after
+
+	returns:
+				nothing
+
+	if node is null src is appended to dest
+
+*******************************************************************************/
+
+void ULList_insert_list_after (
+	ULList *dest,
+	ULList *src,
+	ULList_node *node)
+{
+
+	/***** is node null or tail? then append *****/
+
+	if (!node || node == dest->tail)
+		ULList_append_list (dest, src);
+
+	/***** is src an empty list *****/
+
+	else if (!src->head) {
+	}
+
+	else {
+		src->tail->next = node->next;
+		node->next->prev = src->tail;
+		node->next = src->head;
+		src->head->prev = node;
+	}
+
+	dest->length += src->length;
+	src->head = NULL;
+	src->tail = NULL;
+	src->length = 0;
+
+	return;
+}
+
+/*******************************************************************************
+	slave function to merge 2 sorted runs of an array
+*******************************************************************************/
+
+static void ULList_merge (
+	void **in,
+	void **out,
+	size_t start,
+	size_t middle,
+	size_t end,
+	ULList_data_cmp_func cmp_func)
+{
+	size_t a = start;
+	size_t b = middle;
+	size_t i;
+
+	for (i = start; i < end; i++) {
+		if (a < middle && (b >= end || cmp_func (in[a], in[b]) <= 0))
+			out[i] = in[a++];
+		else
+			out[i] = in[b++];
+	}
+
+	return;
+}
+
+/*******************************************************************************
+	function to sort an unrolled linked list
+
+	Arguments:
+				list		the linked list to sort
+				cmp_func	function to compare the data
+
+	Returns:
+				0 on success
+				non zero if memory could not be allocated, the list is left as it was
+
+	Notes:
+				the sort is stable
+				the sorted list is packed into full nodes
+
+*******************************************************************************/
+
+int ULList_sort (
+	ULList *list,
+	ULList_data_cmp_func cmp_func)
+{
+	void **array = NULL;
+	void **a = NULL;
+	void **b = NULL;
+	void **swap = NULL;
+	void *data = NULL;
+	ULList_node *node = NULL;
+	ULList_node *next = NULL;
+	size_t n = list->length;
+	size_t width;
+	size_t i;
+	size_t j;
+
+	/***** if the list has one or less entries its already sorted *****/
+
+	if (n < 2)
+		return 0;
+
+	if (!(array = malloc (2 * n * sizeof (void *))))
+		return 1;
+
+	/***** copy the data out *****/
+
+	a = array;
+	b = array + n;
+
+	for (i = 0, node = list->head; node; node = node->next) {
+		memcpy (a + i, node->data, node->used * sizeof (void *));
+		i += node->used;
+	}
+
+	/***** insertion sort runs of 8 *****/
+
+	for (i = 0; i < n; i += 8) {
+		for (j = i + 1; j < i + 8 && j < n; j++) {
+			size_t k = j;
+
+			data = a[j];
+			for (; k > i && cmp_func (a[k - 1], data) > 0; k--)
+				a[k] = a[k - 1];
+			a[k] = data;
+		}
+	}
+
+	/***** merge the runs, doubling the width each pass *****/
+
+	for (width = 8; width < n; width *= 2) {
+		for (i = 0; i < n; i += 2 * width) {
+			size_t middle = i + width < n ? i + width : n;
+			size_t end = i + 2 * width < n ? i + 2 * width : n;
+
+			ULList_merge (a, b, i, middle, end, cmp_func);
+		}
+
+		swap = a;
+		a = b;
+		b = swap;
+	}
+
+	/***** copy the data back packing the nodes full *****/
+
+	for (i = 0, node = list->head; i < n; node = node->next) {
+		node->used = n - i < ULLIST_NODESIZE ? n - i : ULLIST_NODESIZE;
+		memcpy (node->data, a + i, node->used * sizeof (void *));
+		i += node->used;
+		list->tail = node;
+	}
+
+	/***** free the nodes we no longer need *****/
+
+	for (; node; node = next) {
+		next = node->next;
+		LLPool_free (list->pool, node);
+	}
+
+	list->tail->next = NULL;
+
+	free (array);
+
+	return 0;
+}
@@ -0,0 +1,259 @@
+/*******************************************************************************
+	WSDeque.c
+
+	work stealing deque
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include "../include/WSDeque.h"
+
+/***** a slot must be written before the bottom that hands it over *****/
+
+#if defined (__x86_64__) || defined (__i386__)
+
+/***** x86 keeps stores in order and loads in order, only gcc must not move them *****/
+
+#define WSDEQUE_ORDER() __asm__ __volatile__ ("" : : : "memory")
+
+#else
+#define WSDEQUE_ORDER() __sync_synchronize ()
+#endif
+
+/***** the slot for a position *****/
+
+#define SLOT(a, i) ((a)->slot[(size_t) (i) & ((a)->size - 1)])
+
+/*******************************************************************************
+	slave function to replace the array with one twice the size, the items
+	from top to bottom are copied and the old array is kept for thieves
+
+	returns:
+				the new array
+				NULL on error
+*******************************************************************************/
+
+static WSDeque_array *WSDeque_grow (
+	WSDeque *list,
+	long top,
+	long bottom)
+{
+	WSDeque_array *old = list->array;
+	WSDeque_array *new = NULL;
+	size_t size = old ? old->size * 2 : WSDEQUE_SIZE;
+	long i;
+
+	if (!(new = malloc (offsetof (WSDeque_array, slot) +
+											size * sizeof (void *))))
+		return NULL;
+
+	new->size = size;
+	new->old = old;
+
+	for (i = top; i < bottom; i++)
+		SLOT (new, i) = SLOT (old, i);
+
+	WSDEQUE_ORDER ();
+	list->array = new;
+
+	return new;
+}
+
+/*******************************************************************************
+	function to push data onto the bottom of a work stealing deque
+
+	Arguments:
+				list	the deque
+				data	the data you wish to store in the deque
+
+	returns:
+				0 on success
+				-1 on error
+
+*******************************************************************************/
+
+int WSDeque_push (
+	WSDeque * list,
+	void *data)
+{
+	long bottom = list->bottom;
+	long top = list->top;
+	WSDeque_array *array = list->array;
+
+	if ((!array || bottom - top >= (long) array->size) &&
+			!(array = WSDeque_grow (list, top, bottom)))
+		return -1;
+
+	SLOT (array, bottom) = data;
+	WSDEQUE_ORDER ();
+	list->bottom = bottom + 1;
+
+	return 0;
+}
+
+/*******************************************************************************
+	function to pop the newest data from the bottom of a work stealing deque
+
+	Arguments:
+				list	the deque
+
+	returns:
+				the data
+				NULL if the deque is empty or a thief took the last item
+
+	notes:
+				the bottom is taken back before the top is read, so a thief
+				either sees the smaller bottom or its steal of the same item
+				moves the top and the owner's swap for it fails
+
+*******************************************************************************/
+
+void *WSDeque_pop (
+	WSDeque * list)
+{
+	long bottom = list->bottom - 1;
+	WSDeque_array *array = list->array;
+	void *result = NULL;
+	long top;
+
+	if (!array)
+		return NULL;
+
+	list->bottom = bottom;
+	__sync_synchronize ();
+	top = list->top;
+
+	if (top <= bottom) {
+		result = SLOT (array, bottom);
+
+		/***** the last item, race the thieves for it *****/
+
+		if (top == bottom) {
+			if (!__sync_bool_compare_and_swap (&list->top, top, top + 1))
+				result = NULL;
+
+			list->bottom = bottom + 1;
+		}
+	}
+
+	else
+		list->bottom = bottom + 1;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to steal the oldest data from the top of a work stealing deque
+
+	Arguments:
+				list	the deque
+
+	returns:
+				the data
+				NULL if the deque is empty or another thread got the item first
+
+*******************************************************************************/
+
+void *WSDeque_steal (
+	WSDeque * list)
+{
+	long top = list->top;
+	WSDeque_array *array = NULL;
+	void *result = NULL;
+	long bottom;
+
+	__sync_synchronize ();
+	bottom = list->bottom;
+
+	if (top < bottom) {
+		WSDEQUE_ORDER ();
+		array = list->array;
+		result = SLOT (array, top);
+
+		if (!__sync_bool_compare_and_swap (&list->top, top, top + 1))
+			result = NULL;
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to count the items in a work stealing deque
+
+	Arguments:
+				list	the deque
+
+	returns:
+				the number of items in the deque
+
+*******************************************************************************/
+
+size_t WSDeque_length (
+	WSDeque * list)
+{
+	long top = list->top;
+	long bottom = list->bottom;
+	size_t result = 0;
+
+	if (bottom > top)
+		result = bottom - top;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete all the items in a work stealing deque and free its
+	arrays
+
+	Arguments:
+				list		the deque
+				function	the function to call to free the data, or NULL
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void WSDeque_delete_all (
+	WSDeque * list,
+	WSDeque_data_free_func function)
+{
+	WSDeque_array *array = NULL;
+	WSDeque_array *old = NULL;
+	long i;
+
+	if (function && list->array) {
+		for (i = list->top; i < list->bottom; i++)
+			function (SLOT (list->array, i));
+	}
+
+	for (array = list->array; array; array = old) {
+		old = array->old;
+		free (array);
+	}
+
+	list->array = NULL;
+	list->top = 0;
+	list->bottom = 0;
+
+	return;
+}
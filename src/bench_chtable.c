@@ -0,0 +1,279 @@
+/*******************************************************************************
+	bench_chtable.c
+
+	part of libLL
+
+	benchmark for the concurrent hash table, 1 to 8 threads doing random
+	finds, inserts and deletes over a fixed set of keys at several read
+	ratios, against a hash table behind one reader writer lock
+
+	usage: bench_chtable [operations [keys]]
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include "../include/HTable.h"
+#include "../include/CHTable.h"
+
+/***** the test settings *****/
+
+static unsigned long operations = 1UL << 21;
+static unsigned long keys = 1UL << 16;
+
+/***** the tables under test *****/
+
+#define BENCH_THREADS 8
+
+static CHTable chtable;
+static HTable htable;
+static pthread_rwlock_t lock = PTHREAD_RWLOCK_INITIALIZER;
+
+/***** what each thread does *****/
+
+typedef struct {
+	int sharded;
+	int reads;
+	unsigned long count;
+	unsigned long seed;
+} bench_job;
+
+/*******************************************************************************
+	function to hash an integer stored in the data pointer
+*******************************************************************************/
+
+static size_t bench_hash (
+	void *data)
+{
+
+	return (size_t) data;
+}
+
+/*******************************************************************************
+	function to compare 2 integers stored in the data pointers
+*******************************************************************************/
+
+static int bench_cmp (
+	void *data1,
+	void *data2)
+{
+
+	return data1 != data2;
+}
+
+/*******************************************************************************
+	function to get the wall clock time in seconds
+*******************************************************************************/
+
+static double bench_time (void)
+{
+	struct timeval tv;
+
+	gettimeofday (&tv, NULL);
+
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/*******************************************************************************
+	thread function, reads percent of the operations are finds, the rest
+	insert or delete a random key with even odds so the tables stay about
+	half full
+*******************************************************************************/
+
+static void *bench_thread (
+	void *extra)
+{
+	bench_job *job = extra;
+	unsigned long seed = job->seed;
+	unsigned long i;
+	void *key = NULL;
+	int op;
+
+	for (i = 0; i < job->count; i++) {
+		seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+		key = (void *) (1 + (seed >> 24) % keys);
+		op = (seed >> 8) % 200;
+
+		if (job->sharded) {
+			if (op < job->reads * 2)
+				CHTable_find (&chtable, key);
+			else if (op & 1)
+				CHTable_insert (&chtable, key);
+			else
+				CHTable_delete (&chtable, key);
+		}
+
+		else if (op < job->reads * 2) {
+			pthread_rwlock_rdlock (&lock);
+			HTable_find (&htable, key);
+			pthread_rwlock_unlock (&lock);
+		}
+
+		else {
+			pthread_rwlock_wrlock (&lock);
+
+			if (op & 1)
+				HTable_insert (&htable, key);
+			else
+				HTable_delete (&htable, key);
+
+			pthread_rwlock_unlock (&lock);
+		}
+	}
+
+	return NULL;
+}
+
+/*******************************************************************************
+	function to check every key can be found and deleted right after it is
+	inserted while the shards grow, and that inserting it again adds nothing
+
+	returns:
+				0 if the table is right
+				1 if not
+*******************************************************************************/
+
+static int bench_check (void)
+{
+	static CHTable check;
+	unsigned long count = keys * 2;
+	unsigned long i;
+	int result = 0;
+
+	check.hash = bench_hash;
+	check.cmp = bench_cmp;
+
+	if (CHTable_init (&check))
+		return 1;
+
+	for (i = 1; i <= count && !result; i++) {
+		if (!CHTable_insert (&check, (void *) i) ||
+				CHTable_find (&check, (void *) i) != (void *) i ||
+				CHTable_insert (&check, (void *) i) != (void *) i ||
+				CHTable_length (&check) != i)
+			result = 1;
+	}
+
+	for (i = 1; i <= count && !result; i += 2) {
+		if (CHTable_delete (&check, (void *) i) != (void *) i ||
+				CHTable_find (&check, (void *) i))
+			result = 1;
+	}
+
+	if (!result && CHTable_length (&check) != count / 2)
+		result = 1;
+
+	CHTable_delete_all (&check);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to run the threads, returns millions of operations a second
+*******************************************************************************/
+
+static double bench_run (
+	int sharded,
+	int reads,
+	int count)
+{
+	pthread_t threads[BENCH_THREADS];
+	bench_job jobs[BENCH_THREADS];
+	double start;
+	int i;
+
+	for (i = 0; i < count; i++) {
+		jobs[i].sharded = sharded;
+		jobs[i].reads = reads;
+		jobs[i].count = operations / count;
+		jobs[i].seed = i + 1;
+	}
+
+	start = bench_time ();
+
+	for (i = 0; i < count; i++)
+		pthread_create (threads + i, NULL, bench_thread, jobs + i);
+
+	for (i = 0; i < count; i++)
+		pthread_join (threads[i], NULL);
+
+	start = bench_time () - start;
+
+	return operations / count * count / start / 1e6;
+}
+
+int main (
+	int argc,
+	char **argv)
+{
+	static int reads[] = { 50, 90, 99 };
+	unsigned long i;
+	int count;
+	int r;
+
+	if (argc > 1)
+		operations = strtoul (argv[1], NULL, 10);
+
+	if (argc > 2)
+		keys = strtoul (argv[2], NULL, 10);
+
+	if (keys < 1)
+		keys = 1;
+
+	if (bench_check ()) {
+		fprintf (stderr, "CHTable lost or duplicated a key while growing\n");
+		return 1;
+	}
+
+	chtable.hash = bench_hash;
+	chtable.cmp = bench_cmp;
+	htable.hash = bench_hash;
+	htable.cmp = bench_cmp;
+
+	if (CHTable_init (&chtable)) {
+		fprintf (stderr, "CHTable_init failed\n");
+		return 1;
+	}
+
+	/***** start both half full *****/
+
+	for (i = 1; i <= keys; i += 2) {
+		CHTable_insert (&chtable, (void *) i);
+		HTable_insert (&htable, (void *) i);
+	}
+
+	printf ("%lu operations, %lu keys, millions of operations a second\n",
+					operations, keys);
+	printf ("%6s %8s %10s %14s\n", "reads", "threads", "CHTable", "rwlock HTable");
+
+	for (r = 0; r < (int) (sizeof (reads) / sizeof (reads[0])); r++) {
+		for (count = 1; count <= BENCH_THREADS; count *= 2) {
+			printf ("%5d%% %8d %10.2f %14.2f\n", reads[r], count,
+							bench_run (1, reads[r], count), bench_run (0, reads[r], count));
+		}
+	}
+
+	CHTable_delete_all (&chtable);
+	HTable_delete_all (&htable);
+
+	return 0;
+}
@@ -0,0 +1,309 @@
+/*******************************************************************************
+	bench_copy.c
+
+	part of libLL
+
+	benchmark for the all or nothing list copies, first checks that a copy
+	that fails part way leaves the dest as it was and frees every copy made,
+	for each list and end, then prints the time to copy a list with the old
+	copy and with the all or nothing copy, with and without a pool and an
+	arena
+
+	usage: bench_copy [length] [repeats]
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/time.h>
+#include "../include/LLPool.h"
+#include "../include/LLArena.h"
+#include "../include/DLList.h"
+#include "../include/SLList.h"
+#include "../include/CLList.h"
+#include "../include/QLList.h"
+#include "../include/DQLList.h"
+#include "../include/stack.h"
+
+/***** the copy fails when it gets to this many, less than 0 for never *****/
+
+static long fail_at = -1;
+static long copies = 0;
+static long live = 0;
+
+/*******************************************************************************
+	function to copy an integer, from the arena if there is one
+*******************************************************************************/
+
+static void *bench_copy (
+	void **dest,
+	void *src,
+	LLArena *arena)
+{
+	long *result = NULL;
+
+	if (copies++ == fail_at)
+		return NULL;
+
+	if (arena)
+		result = LLArena_alloc (arena, sizeof (long));
+	else if ((result = malloc (sizeof (long))))
+		live++;
+
+	if (result) {
+		*result = *(long *) src;
+		*dest = result;
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to copy an integer for the old copy functions
+*******************************************************************************/
+
+static void *bench_copy_old (
+	void **dest,
+	void *src)
+{
+
+	return bench_copy (dest, src, NULL);
+}
+
+/*******************************************************************************
+	function to free a copy made without an arena
+*******************************************************************************/
+
+static void bench_free (
+	void *data)
+{
+
+	live--;
+	free (data);
+
+	return;
+}
+
+/*******************************************************************************
+	function to get the wall clock time in seconds
+*******************************************************************************/
+
+static double bench_time (void)
+{
+	struct timeval tv;
+
+	gettimeofday (&tv, NULL);
+
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/*******************************************************************************
+	function to make each copy fail at each point, for each list and end
+
+	returns:
+				0 if every failed copy left the dest as it was and freed its
+				copies
+				1 if not
+*******************************************************************************/
+
+static int bench_check (
+	DLList *dsrc,
+	SLList *ssrc)
+{
+	DLList dlist = { 0 };
+	SLList slist = { 0 };
+	CLList clist = { 0 };
+	QLList qlist = { 0 };
+	DQLList dqlist = { 0 };
+	stackLList stack = { 0 };
+	LLArena arena = { 0 };
+	LLArena_mark mark;
+	int failed[9];
+	long n = dsrc->length;
+	int result = 0;
+	int i;
+
+	for (fail_at = 0; fail_at < n && !result; fail_at++) {
+		copies = 0;
+		failed[0] = DLList_append_list_copy_arena (&dlist, dsrc, bench_copy,
+																							 bench_free, NULL);
+		copies = 0;
+		failed[1] = DLList_prepend_list_copy_arena (&dlist, dsrc, bench_copy,
+																								bench_free, NULL);
+		copies = 0;
+		failed[2] = SLList_append_list_copy_arena (&slist, ssrc, bench_copy,
+																							 bench_free, NULL);
+		copies = 0;
+		failed[3] = SLList_prepend_list_copy_arena (&slist, ssrc, bench_copy,
+																								bench_free, NULL);
+		copies = 0;
+		failed[4] = CLList_append_list_copy_arena (&clist, (CLList *) dsrc,
+																							 bench_copy, bench_free, NULL);
+		copies = 0;
+		failed[5] = QLList_push_list_copy_arena (&qlist, (QLList *) dsrc,
+																						 bench_copy, bench_free, NULL);
+		copies = 0;
+		failed[6] = DQLList_push_list_copy_arena (&dqlist, (DQLList *) dsrc,
+																							bench_copy, bench_free, NULL);
+		copies = 0;
+		failed[7] = stackLList_push_list_copy_arena (&stack, (stackLList *) ssrc,
+																								 bench_copy, bench_free, NULL);
+
+		/***** with an arena nothing needs freeing, the arena goes back *****/
+
+		copies = 0;
+		LLArena_save (&arena, &mark);
+		failed[8] = DLList_prepend_list_copy_arena (&dlist, dsrc, bench_copy, NULL,
+																								&arena);
+		failed[8] &= arena.chunk == mark.chunk && arena.used == mark.used;
+
+		for (i = 0; i < 9; i++) {
+			if (!failed[i])
+				result = 1;
+		}
+
+		if (live || dlist.length || slist.length || clist.length ||
+				qlist.length || dqlist.length || stack.length)
+			result = 1;
+	}
+
+	fail_at = -1;
+	LLArena_delete_all (&arena);
+
+	return result;
+}
+
+/*******************************************************************************
+	functions to copy a list repeats times, they return the seconds it took
+*******************************************************************************/
+
+static double bench_old (
+	DLList *src,
+	int repeats,
+	LLPool *pool)
+{
+	DLList dest = { 0 };
+	double start;
+	int i;
+
+	dest.pool = pool;
+
+	start = bench_time ();
+	for (i = 0; i < repeats; i++) {
+		DLList_append_list_copy (&dest, src, bench_copy_old);
+		DLList_delete_all (&dest, bench_free);
+	}
+
+	return bench_time () - start;
+}
+
+static double bench_arena (
+	DLList *src,
+	int repeats,
+	LLPool *pool,
+	LLArena *arena)
+{
+	DLList dest = { 0 };
+	LLArena_mark mark;
+	double start;
+	int i;
+
+	dest.pool = pool;
+
+	start = bench_time ();
+	for (i = 0; i < repeats; i++) {
+		if (arena)
+			LLArena_save (arena, &mark);
+
+		DLList_append_list_copy_arena (&dest, src, bench_copy, bench_free,
+																	 arena);
+		DLList_delete_all (&dest, arena ? NULL : bench_free);
+
+		if (arena)
+			LLArena_release (arena, &mark);
+	}
+
+	return bench_time () - start;
+}
+
+int main (
+	int argc,
+	char **argv)
+{
+	DLList dsrc = { 0 };
+	SLList ssrc = { 0 };
+	LLPool pool = { 0 };
+	LLArena arena = { 0 };
+	size_t length = 10000;
+	int repeats = 100;
+	long *keys = NULL;
+	size_t i;
+
+	if (argc > 1)
+		length = strtoul (argv[1], NULL, 10);
+
+	if (argc > 2)
+		repeats = atoi (argv[2]);
+
+	if (!(keys = malloc ((length + 8) * sizeof (long)))) {
+		fprintf (stderr, "out of memory\n");
+		return 1;
+	}
+
+	/***** check on a short list, every failure point is tried *****/
+
+	for (i = 0; i < 8; i++) {
+		keys[i] = i;
+		DLList_append (&dsrc, keys + i);
+		SLList_append (&ssrc, keys + i);
+	}
+
+	if (bench_check (&dsrc, &ssrc)) {
+		fprintf (stderr, "a failed copy changed the dest or leaked a copy\n");
+		return 1;
+	}
+
+	DLList_delete_all (&dsrc, NULL);
+	SLList_delete_all (&ssrc, NULL);
+
+	for (i = 0; i < length; i++) {
+		keys[i] = i;
+		DLList_append (&dsrc, keys + i);
+	}
+
+	printf ("%lu nodes copied %d times\n", (unsigned long) length, repeats);
+	printf ("%-32s %8.3fs\n", "DLList_append_list_copy",
+					bench_old (&dsrc, repeats, NULL));
+	printf ("%-32s %8.3fs\n", "  with a pool",
+					bench_old (&dsrc, repeats, &pool));
+	printf ("%-32s %8.3fs\n", "DLList_append_list_copy_arena",
+					bench_arena (&dsrc, repeats, NULL, NULL));
+	printf ("%-32s %8.3fs\n", "  with a pool",
+					bench_arena (&dsrc, repeats, &pool, NULL));
+	printf ("%-32s %8.3fs\n", "  with a pool and an arena",
+					bench_arena (&dsrc, repeats, &pool, &arena));
+
+	DLList_delete_all (&dsrc, NULL);
+	LLPool_delete_all (&pool);
+	LLArena_delete_all (&arena);
+	free (keys);
+
+	return 0;
+}
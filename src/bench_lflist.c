@@ -0,0 +1,275 @@
+/*******************************************************************************
+	bench_lflist.c
+
+	part of libLL
+
+	benchmark for the lock free list against a single linked list behind a
+	mutex, prints the operations per second at 1 to 64 threads for a mix of
+	finds, inserts and deletes on a set of keys
+
+	usage: bench_lflist [operations [keys [find percent]]]
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include "../include/SLList.h"
+#include "../include/LFList.h"
+
+/***** the test settings *****/
+
+static size_t operations = 2000000;
+static long keys = 1024;
+static int finds = 90;
+
+/***** the structures under test *****/
+
+static LFList lflist;
+static SLList sllist;
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*******************************************************************************
+	function to compare 2 integers stored in the data pointers
+*******************************************************************************/
+
+static int bench_cmp (
+	void *data1,
+	void *data2)
+{
+	long a = (long) data1;
+	long b = (long) data2;
+
+	return (a > b) - (a < b);
+}
+
+/*******************************************************************************
+	function to get the wall clock time in seconds
+*******************************************************************************/
+
+static double bench_time (void)
+{
+	struct timeval tv;
+
+	gettimeofday (&tv, NULL);
+
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/*******************************************************************************
+	function to get a random number for a thread
+*******************************************************************************/
+
+static unsigned long bench_rand (
+	unsigned long *seed)
+{
+
+	*seed = *seed * 6364136223846793005UL + 1442695040888963407UL;
+
+	return *seed >> 33;
+}
+
+/*******************************************************************************
+	functions for the mutex list, a walk to find where the key goes
+*******************************************************************************/
+
+static SLList_node *sllist_before (
+	long key)
+{
+	SLList_node *node = NULL;
+	SLList_node *prev = NULL;
+
+	for (node = sllist.head; node && (long) node->data < key; node = node->next)
+		prev = node;
+
+	return prev;
+}
+
+static void sllist_op (
+	int op,
+	long key)
+{
+	SLList_node *prev = NULL;
+	SLList_node *node = NULL;
+
+	pthread_mutex_lock (&mutex);
+
+	prev = sllist_before (key);
+	node = prev ? prev->next : sllist.head;
+
+	if (op == 0) {
+	}
+
+	else if (op == 1) {
+		if (!node || (long) node->data != key) {
+			if (!prev)
+				SLList_prepend (&sllist, (void *) key);
+			else
+				SLList_insert_after (&sllist, prev, (void *) key);
+		}
+	}
+
+	else if (node && (long) node->data == key) {
+		if (!prev)
+			SLList_delete (&sllist, node);
+		else
+			SLList_delete_after (&sllist, prev);
+	}
+
+	pthread_mutex_unlock (&mutex);
+
+	return;
+}
+
+/*******************************************************************************
+	thread functions, each runs its share of the operations
+*******************************************************************************/
+
+typedef struct {
+	unsigned long seed;
+	size_t ops;
+	int lockfree;
+} bench_job;
+
+static void *bench_thread (
+	void *extra)
+{
+	bench_job *job = extra;
+	LFList_thread *thread = NULL;
+	unsigned long r;
+	size_t i;
+	long key;
+	int op;
+
+	if (job->lockfree && !(thread = LFList_thread_get (&lflist)))
+		return NULL;
+
+	for (i = 0; i < job->ops; i++) {
+		r = bench_rand (&job->seed);
+		key = r % keys;
+		r = (r / keys) % 100;
+		op = r < (unsigned long) finds ? 0 : r % 2 ? 1 : 2;
+
+		if (!job->lockfree)
+			sllist_op (op, key);
+		else if (op == 0)
+			LFList_find (&lflist, thread, (void *) key);
+		else if (op == 1)
+			LFList_insert (&lflist, thread, (void *) key);
+		else
+			LFList_delete (&lflist, thread, (void *) key);
+	}
+
+	if (thread)
+		LFList_thread_release (&lflist, thread);
+
+	return NULL;
+}
+
+/*******************************************************************************
+	function to run the mix on one structure with some threads, returns the
+	seconds it took
+*******************************************************************************/
+
+static double bench_run (
+	int lockfree,
+	int nthreads)
+{
+	pthread_t threads[64];
+	bench_job jobs[64];
+	LFList_thread *thread = NULL;
+	double start;
+	long key;
+	int i;
+
+	/***** fill half the keys *****/
+
+	lflist.cmp = bench_cmp;
+
+	if (lockfree)
+		thread = LFList_thread_get (&lflist);
+
+	for (key = 0; key < keys; key += 2) {
+		if (lockfree)
+			LFList_insert (&lflist, thread, (void *) key);
+		else
+			SLList_append (&sllist, (void *) key);
+	}
+
+	if (thread)
+		LFList_thread_release (&lflist, thread);
+
+	for (i = 0; i < nthreads; i++) {
+		jobs[i].seed = i + 1;
+		jobs[i].ops = operations / nthreads;
+		jobs[i].lockfree = lockfree;
+	}
+
+	start = bench_time ();
+
+	for (i = 0; i < nthreads; i++)
+		pthread_create (threads + i, NULL, bench_thread, jobs + i);
+
+	for (i = 0; i < nthreads; i++)
+		pthread_join (threads[i], NULL);
+
+	start = bench_time () - start;
+
+	LFList_delete_all (&lflist);
+	SLList_delete_all (&sllist, NULL);
+
+	return start;
+}
+
+int main (
+	int argc,
+	char **argv)
+{
+	double locked;
+	double lockfree;
+	int nthreads;
+
+	if (argc > 1)
+		operations = strtoul (argv[1], NULL, 10);
+
+	if (argc > 2)
+		keys = strtol (argv[2], NULL, 10);
+
+	if (argc > 3)
+		finds = atoi (argv[3]);
+
+	if (keys < 1)
+		keys = 1;
+
+	printf ("%lu operations on %ld keys, %d%% finds\n",
+					(unsigned long) operations, keys, finds);
+	printf ("%8s %16s %16s\n", "threads", "mutex SLList", "LFList");
+
+	for (nthreads = 1; nthreads <= 64; nthreads *= 2) {
+		locked = bench_run (0, nthreads);
+		lockfree = bench_run (1, nthreads);
+
+		printf ("%8d %12.0f ops %12.0f ops\n", nthreads,
+						operations / locked, operations / lockfree);
+	}
+
+	return 0;
+}
@@ -0,0 +1,228 @@
+/*******************************************************************************
+	bench_mpqueue.c
+
+	part of libLL
+
+	benchmark for the bounded multi producer que, prints the items per second
+	for 1 to 4 producers against 1 to 4 consumers, one item at a time and in
+	batches, with the lock free linked list que alongside
+
+	usage: bench_mpqueue [items [batch]]
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/time.h>
+#include "../include/MPQueue.h"
+#include "../include/LFQueue.h"
+
+/***** the test settings *****/
+
+static size_t items = 1000000;
+static size_t batch = 32;
+
+/***** the ques under test *****/
+
+static MPQueue mpqueue;
+static LFQueue lfqueue;
+
+/***** how the threads use the ques *****/
+
+#define BENCH_MPQUEUE 0
+#define BENCH_MPQUEUE_N 1
+#define BENCH_LFQUEUE 2
+
+typedef struct {
+	int mode;
+	size_t count;
+} bench_job;
+
+/*******************************************************************************
+	function to get the wall clock time in seconds
+*******************************************************************************/
+
+static double bench_time (void)
+{
+	struct timeval tv;
+
+	gettimeofday (&tv, NULL);
+
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/*******************************************************************************
+	thread function for a producer, pushes count items
+*******************************************************************************/
+
+static void *bench_push (
+	void *extra)
+{
+	bench_job *job = extra;
+	void *array[256];
+	size_t i = 0;
+	size_t n;
+	size_t j;
+
+	while (i < job->count) {
+		if (job->mode == BENCH_MPQUEUE)
+			MPQueue_push (&mpqueue, (void *) ++i);
+
+		else if (job->mode == BENCH_LFQUEUE)
+			LFQueue_push (&lfqueue, (void *) ++i);
+
+		else {
+			n = job->count - i < batch ? job->count - i : batch;
+
+			for (j = 0; j < n; j++)
+				array[j] = (void *) (i + j + 1);
+
+			for (j = 0; (j += MPQueue_push_n (&mpqueue, array + j, n - j)) < n; )
+				sched_yield ();
+
+			i += n;
+		}
+	}
+
+	return NULL;
+}
+
+/*******************************************************************************
+	thread function for a consumer, pulls count items
+*******************************************************************************/
+
+static void *bench_pull (
+	void *extra)
+{
+	bench_job *job = extra;
+	void *array[256];
+	size_t i = 0;
+	size_t n;
+
+	while (i < job->count) {
+		if (job->mode == BENCH_MPQUEUE) {
+			MPQueue_pull (&mpqueue);
+			i++;
+		}
+
+		else if (job->mode == BENCH_LFQUEUE) {
+			if (LFQueue_pull (&lfqueue))
+				i++;
+			else
+				sched_yield ();
+		}
+
+		else {
+			n = job->count - i < batch ? job->count - i : batch;
+
+			if ((n = MPQueue_pull_n (&mpqueue, array, n)))
+				i += n;
+			else
+				sched_yield ();
+		}
+	}
+
+	return NULL;
+}
+
+/*******************************************************************************
+	function to run some producers and consumers on one que, returns the
+	seconds it took
+*******************************************************************************/
+
+static double bench_run (
+	int mode,
+	int producers,
+	int consumers,
+	size_t total)
+{
+	pthread_t threads[8];
+	bench_job push;
+	bench_job pull;
+	double start;
+	int i;
+
+	push.mode = pull.mode = mode;
+	push.count = total / producers;
+	pull.count = total / consumers;
+
+	start = bench_time ();
+
+	for (i = 0; i < consumers; i++)
+		pthread_create (threads + i, NULL, bench_pull, &pull);
+
+	for (i = 0; i < producers; i++)
+		pthread_create (threads + consumers + i, NULL, bench_push, &push);
+
+	for (i = 0; i < consumers + producers; i++)
+		pthread_join (threads[i], NULL);
+
+	start = bench_time () - start;
+
+	MPQueue_delete_all (&mpqueue, NULL);
+	LFQueue_delete_all (&lfqueue, NULL);
+
+	return start;
+}
+
+int main (
+	int argc,
+	char **argv)
+{
+	double times[3];
+	size_t total;
+	int producers;
+	int consumers;
+	int mode;
+
+	if (argc > 1)
+		items = strtoul (argv[1], NULL, 10);
+
+	if (argc > 2)
+		batch = strtoul (argv[2], NULL, 10);
+
+	if (batch < 1 || batch > 256)
+		batch = 32;
+
+	printf ("%lu items, batches of %lu, %d slots\n", (unsigned long) items,
+					(unsigned long) batch, MPQUEUE_SIZE);
+	printf ("%4s %4s %14s %14s %14s\n", "prod", "cons", "MPQueue",
+					"MPQueue_n", "LFQueue");
+
+	for (producers = 1; producers <= 4; producers *= 2) {
+		for (consumers = 1; consumers <= 4; consumers *= 2) {
+
+			/***** every producer and consumer gets an equal share *****/
+
+			total = items / (producers * consumers) * producers * consumers;
+
+			for (mode = 0; mode < 3; mode++)
+				times[mode] = bench_run (mode, producers, consumers, total);
+
+			printf ("%4d %4d %10.0f i/s %10.0f i/s %10.0f i/s\n",
+							producers, consumers, total / times[0], total / times[1],
+							total / times[2]);
+		}
+	}
+
+	return 0;
+}
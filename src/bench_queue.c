@@ -0,0 +1,203 @@
+/*******************************************************************************
+	bench_queue.c
+
+	part of libLL
+
+	benchmark for the lock free que against a que behind a mutex, prints the
+	items per second with 1 to 16 producer and consumer pairs all pushing and
+	pulling at once
+
+	usage: bench_queue [items]
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/time.h>
+#include "../include/QLList.h"
+#include "../include/LFQueue.h"
+
+/***** the test settings *****/
+
+static size_t items = 1000000;
+
+/***** the ques under test *****/
+
+static QLList qllist;
+static LFQueue lfqueue;
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/***** items still to be pulled *****/
+
+static volatile long left;
+
+/*******************************************************************************
+	function to get the wall clock time in seconds
+*******************************************************************************/
+
+static double bench_time (void)
+{
+	struct timeval tv;
+
+	gettimeofday (&tv, NULL);
+
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/*******************************************************************************
+	thread functions for the mutex que
+*******************************************************************************/
+
+static void *bench_qllist_push (
+	void *extra)
+{
+	size_t count = (size_t) extra;
+	size_t i;
+
+	for (i = 1; i <= count; i++) {
+		pthread_mutex_lock (&mutex);
+		QLList_push (&qllist, (void *) i);
+		pthread_mutex_unlock (&mutex);
+	}
+
+	return NULL;
+}
+
+static void *bench_qllist_pull (
+	void *extra)
+{
+	void *data;
+
+	(void) extra;
+
+	while (left > 0) {
+		data = NULL;
+
+		pthread_mutex_lock (&mutex);
+
+		if (qllist.length)
+			data = QLList_pull (&qllist);
+
+		pthread_mutex_unlock (&mutex);
+
+		if (data)
+			__sync_fetch_and_sub (&left, 1);
+		else
+			sched_yield ();
+	}
+
+	return NULL;
+}
+
+/*******************************************************************************
+	thread functions for the lock free que
+*******************************************************************************/
+
+static void *bench_lfqueue_push (
+	void *extra)
+{
+	size_t count = (size_t) extra;
+	size_t i;
+
+	for (i = 1; i <= count; i++)
+		LFQueue_push (&lfqueue, (void *) i);
+
+	return NULL;
+}
+
+static void *bench_lfqueue_pull (
+	void *extra)
+{
+
+	(void) extra;
+
+	while (left > 0) {
+		if (LFQueue_pull (&lfqueue))
+			__sync_fetch_and_sub (&left, 1);
+		else
+			sched_yield ();
+	}
+
+	return NULL;
+}
+
+/*******************************************************************************
+	function to run the producers and consumers on one que, returns the
+	seconds it took
+*******************************************************************************/
+
+static double bench_run (
+	int lockfree,
+	int pairs)
+{
+	pthread_t threads[32];
+	size_t count = items / pairs;
+	double start;
+	int i;
+
+	left = count * pairs;
+
+	start = bench_time ();
+
+	for (i = 0; i < pairs; i++) {
+		pthread_create (threads + 2 * i, NULL,
+										lockfree ? bench_lfqueue_pull : bench_qllist_pull, NULL);
+		pthread_create (threads + 2 * i + 1, NULL,
+										lockfree ? bench_lfqueue_push : bench_qllist_push,
+										(void *) count);
+	}
+
+	for (i = 0; i < 2 * pairs; i++)
+		pthread_join (threads[i], NULL);
+
+	start = bench_time () - start;
+
+	QLList_delete_all (&qllist, NULL);
+	LFQueue_delete_all (&lfqueue, NULL);
+
+	return start;
+}
+
+int main (
+	int argc,
+	char **argv)
+{
+	double locked;
+	double lockfree;
+	int pairs;
+
+	if (argc > 1)
+		items = strtoul (argv[1], NULL, 10);
+
+	printf ("%lu items\n", (unsigned long) items);
+	printf ("%8s %16s %16s\n", "pairs", "mutex QLList", "LFQueue");
+
+	for (pairs = 1; pairs <= 16; pairs *= 2) {
+		locked = bench_run (0, pairs);
+		lockfree = bench_run (1, pairs);
+
+		printf ("%8d %12.0f i/s %12.0f i/s\n", pairs,
+						items / locked, items / lockfree);
+	}
+
+	return 0;
+}
@@ -0,0 +1,243 @@
+/*******************************************************************************
+	bench_skiplist.c
+
+	part of libLL
+
+	benchmark for the skip list against the binary search tree, prints the time
+	to insert every key then find every key in a random order, for keys
+	inserted sorted and in random order
+
+	usage: bench_skiplist [length]
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/time.h>
+#include "../include/BSTree.h"
+#include "../include/SkipList.h"
+
+/*******************************************************************************
+	function to compare 2 integers stored in the data pointers
+*******************************************************************************/
+
+static int bench_cmp (
+	void *data1,
+	void *data2)
+{
+	long a = (long) data1;
+	long b = (long) data2;
+
+	return (a > b) - (a < b);
+}
+
+/*******************************************************************************
+	function to get the wall clock time in seconds
+*******************************************************************************/
+
+static double bench_time (void)
+{
+	struct timeval tv;
+
+	gettimeofday (&tv, NULL);
+
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/*******************************************************************************
+	functions to run each structure, they set the seconds the inserts and finds
+	took and return the number of keys not found
+*******************************************************************************/
+
+static size_t bench_BSTree (
+	void **in,
+	void **keys,
+	size_t n,
+	double *insert,
+	double *find)
+{
+	BSTree tree = { 0 };
+	BSTree_node *node = NULL;
+	BSTree_node **stack = NULL;
+	size_t depth = 0;
+	size_t missed = 0;
+	double start;
+	size_t i;
+
+	tree.cmp = bench_cmp;
+
+	start = bench_time ();
+	for (i = 0; i < n; i++)
+		BSTree_insert (&tree, in[i]);
+	*insert = bench_time () - start;
+
+	start = bench_time ();
+	for (i = 0; i < n; i++) {
+		if (!BSTree_find (&tree, keys[i]))
+			missed++;
+	}
+	*find = bench_time () - start;
+
+	/***** the tree may be a chain, free it with a stack not recursion *****/
+
+	if (!(stack = malloc ((n + 1) * sizeof (BSTree_node *)))) {
+		fprintf (stderr, "out of memory\n");
+		exit (1);
+	}
+
+	if (tree.root)
+		stack[depth++] = tree.root;
+
+	while (depth) {
+		node = stack[--depth];
+
+		if (node->left)
+			stack[depth++] = node->left;
+		if (node->right)
+			stack[depth++] = node->right;
+
+		free (node);
+	}
+
+	free (stack);
+
+	return missed;
+}
+
+static size_t bench_SkipList (
+	void **in,
+	void **keys,
+	size_t n,
+	double *insert,
+	double *find)
+{
+	SkipList list = { 0 };
+	size_t missed = 0;
+	double start;
+	size_t i;
+
+	list.cmp = bench_cmp;
+
+	start = bench_time ();
+	for (i = 0; i < n; i++)
+		SkipList_insert (&list, in[i]);
+	*insert = bench_time () - start;
+
+	start = bench_time ();
+	for (i = 0; i < n; i++) {
+		if (!SkipList_find (&list, keys[i]))
+			missed++;
+	}
+	*find = bench_time () - start;
+
+	SkipList_delete_all (&list);
+
+	return missed;
+}
+
+/***** the structures to benchmark *****/
+
+static struct {
+	const char *name;
+	size_t (*run) (void **in, void **keys, size_t n, double *insert,
+								 double *find);
+} structs[] = {
+	{ "BSTree", bench_BSTree },
+	{ "SkipList", bench_SkipList },
+	{ NULL, NULL }
+};
+
+/*******************************************************************************
+	function to shuffle an array
+*******************************************************************************/
+
+static void shuffle (
+	void **array,
+	size_t n)
+{
+	void *tmp = NULL;
+	size_t i;
+	size_t j;
+
+	for (i = n; i > 1; i--) {
+		j = ((size_t) rand () * ((size_t) RAND_MAX + 1) + rand ()) % i;
+		tmp = array[i - 1];
+		array[i - 1] = array[j];
+		array[j] = tmp;
+	}
+
+	return;
+}
+
+int main (
+	int argc,
+	char **argv)
+{
+	void **in = NULL;
+	void **keys = NULL;
+	size_t n = 20000;
+	size_t missed;
+	double insert;
+	double find;
+	int p;
+	int i;
+	size_t j;
+
+	if (argc > 1)
+		n = strtoul (argv[1], NULL, 10);
+
+	if (!(in = malloc (n * sizeof (void *))) ||
+			!(keys = malloc (n * sizeof (void *)))) {
+		fprintf (stderr, "out of memory\n");
+		return 1;
+	}
+
+	srand (1);
+
+	for (j = 0; j < n; j++)
+		keys[j] = (void *) (long) j;
+	shuffle (keys, n);
+
+	printf ("%-10s %-10s %10s %10s\n", "input", "struct", "insert", "find");
+
+	for (p = 0; p < 2; p++) {
+		for (j = 0; j < n; j++)
+			in[j] = (void *) (long) j;
+
+		if (p)
+			shuffle (in, n);
+
+		for (i = 0; structs[i].name; i++) {
+			missed = structs[i].run (in, keys, n, &insert, &find);
+
+			if (missed)
+				printf ("%-10s %-10s %10s %lu missed\n", p ? "random" : "sorted",
+								structs[i].name, "FAILED", (unsigned long) missed);
+			else
+				printf ("%-10s %-10s %10.3f %10.3f\n", p ? "random" : "sorted",
+								structs[i].name, insert, find);
+		}
+	}
+
+	free (keys);
+	free (in);
+
+	return 0;
+}
@@ -0,0 +1,422 @@
+/*******************************************************************************
+	bench_sort.c
+
+	part of libLL
+
+	benchmark for the list sorts, prints the compares and time each sort takes
+	on sorted, reversed, nearly sorted and random input
+
+	usage: bench_sort [length [threads]]
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/time.h>
+#include "../include/SLList.h"
+#include "../include/DLList.h"
+
+/***** number of compares made by the current sort *****/
+
+static size_t compares = 0;
+
+/***** threads for the parallel sort *****/
+
+static size_t threads = 4;
+
+/*******************************************************************************
+	function to compare 2 integers stored in the data pointers, counting calls
+*******************************************************************************/
+
+static int bench_cmp (
+	void *data1,
+	void *data2)
+{
+	long a = (long) data1;
+	long b = (long) data2;
+
+	compares++;
+
+	return (a > b) - (a < b);
+}
+
+/*******************************************************************************
+	function to compare 2 integers stored in the data pointers, for the sorts
+	that call it from several threads so it cant count
+*******************************************************************************/
+
+static int bench_cmp_mt (
+	void *data1,
+	void *data2)
+{
+	long a = (long) data1;
+	long b = (long) data2;
+
+	return (a > b) - (a < b);
+}
+
+/*******************************************************************************
+	function to get the integer stored in the data pointer as a radix sort key
+*******************************************************************************/
+
+static unsigned long long bench_key (
+	void *data)
+{
+
+	return (unsigned long) data;
+}
+
+/*******************************************************************************
+	function to get the wall clock time in seconds, clock () adds up the time
+	of all the threads
+*******************************************************************************/
+
+static double bench_time (void)
+{
+	struct timeval tv;
+
+	gettimeofday (&tv, NULL);
+
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/*******************************************************************************
+	functions to run each sort, they return the seconds the sort took or a
+	negative value if the result was not sorted
+*******************************************************************************/
+
+static double bench_SLList (
+	void **in,
+	size_t n,
+	void (*sort) (SLList *, SLList_data_cmp_func))
+{
+	SLList list = { 0 };
+	SLList_node *node = NULL;
+	double start;
+	double result;
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		SLList_append (&list, in[i]);
+
+	compares = 0;
+	start = bench_time ();
+	sort (&list, bench_cmp);
+	result = bench_time () - start;
+
+	for (node = list.head; node && node->next; node = node->next) {
+		if ((long) node->data > (long) node->next->data)
+			result = -1;
+	}
+
+	SLList_delete_all (&list, NULL);
+
+	return result;
+}
+
+static double bench_DLList (
+	void **in,
+	size_t n,
+	void (*sort) (DLList *, DLList_data_cmp_func))
+{
+	DLList list = { 0 };
+	DLList_node *node = NULL;
+	double start;
+	double result;
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		DLList_append (&list, in[i]);
+
+	compares = 0;
+	start = bench_time ();
+	sort (&list, bench_cmp);
+	result = bench_time () - start;
+
+	for (node = list.head; node && node->next; node = node->next) {
+		if ((long) node->data > (long) node->next->data ||
+				node->next->prev != node)
+			result = -1;
+	}
+
+	if (list.tail != node)
+		result = -1;
+
+	DLList_delete_all (&list, NULL);
+
+	return result;
+}
+
+static double run_SLList_sort (
+	void **in,
+	size_t n)
+{
+
+	return bench_SLList (in, n, SLList_sort);
+}
+
+static double run_SLList_sort_adaptive (
+	void **in,
+	size_t n)
+{
+
+	return bench_SLList (in, n, SLList_sort_adaptive);
+}
+
+static void sort_SLList_array (
+	SLList *list,
+	SLList_data_cmp_func cmp_func)
+{
+
+	SLList_sort_array (list, cmp_func, 0);
+}
+
+static double run_SLList_sort_array (
+	void **in,
+	size_t n)
+{
+
+	return bench_SLList (in, n, sort_SLList_array);
+}
+
+static void sort_SLList_array_relocate (
+	SLList *list,
+	SLList_data_cmp_func cmp_func)
+{
+	SLList_sort_array (list, cmp_func, 1);
+}
+
+static double run_SLList_sort_array_relocate (
+	void **in,
+	size_t n)
+{
+
+	return bench_SLList (in, n, sort_SLList_array_relocate);
+}
+
+static void sort_SLList_radix (
+	SLList *list,
+	SLList_data_cmp_func cmp_func)
+{
+
+	(void) cmp_func;
+
+	SLList_sort_radix (list, bench_key);
+}
+
+static double run_SLList_sort_radix (
+	void **in,
+	size_t n)
+{
+
+	return bench_SLList (in, n, sort_SLList_radix);
+}
+
+static double run_DLList_sort (
+	void **in,
+	size_t n)
+{
+
+	return bench_DLList (in, n, DLList_sort);
+}
+
+static double run_DLList_sort_adaptive (
+	void **in,
+	size_t n)
+{
+
+	return bench_DLList (in, n, DLList_sort_adaptive);
+}
+
+static void sort_DLList_array (
+	DLList *list,
+	DLList_data_cmp_func cmp_func)
+{
+
+	DLList_sort_array (list, cmp_func, 0);
+}
+
+static double run_DLList_sort_array (
+	void **in,
+	size_t n)
+{
+
+	return bench_DLList (in, n, sort_DLList_array);
+}
+
+static void sort_DLList_array_relocate (
+	DLList *list,
+	DLList_data_cmp_func cmp_func)
+{
+	DLList_sort_array (list, cmp_func, 1);
+}
+
+static double run_DLList_sort_array_relocate (
+	void **in,
+	size_t n)
+{
+
+	return bench_DLList (in, n, sort_DLList_array_relocate);
+}
+
+static void sort_DLList_radix (
+	DLList *list,
+	DLList_data_cmp_func cmp_func)
+{
+
+	(void) cmp_func;
+
+	DLList_sort_radix (list, bench_key);
+}
+
+static double run_DLList_sort_radix (
+	void **in,
+	size_t n)
+{
+
+	return bench_DLList (in, n, sort_DLList_radix);
+}
+
+static void sort_DLList_parallel (
+	DLList *list,
+	DLList_data_cmp_func cmp_func)
+{
+
+	(void) cmp_func;
+
+	DLList_sort_parallel (list, bench_cmp_mt, threads);
+	compares = (size_t) -1;
+}
+
+static double run_DLList_sort_parallel (
+	void **in,
+	size_t n)
+{
+
+	return bench_DLList (in, n, sort_DLList_parallel);
+}
+
+/***** the sorts to benchmark *****/
+
+static struct {
+	const char *name;
+	double (*run) (void **in, size_t n);
+} sorts[] = {
+	{ "SLList_sort", run_SLList_sort },
+	{ "SLList_sort_adaptive", run_SLList_sort_adaptive },
+	{ "SLList_sort_array", run_SLList_sort_array },
+	{ "SLList_sort_array relocate", run_SLList_sort_array_relocate },
+	{ "SLList_sort_radix", run_SLList_sort_radix },
+	{ "DLList_sort", run_DLList_sort },
+	{ "DLList_sort_adaptive", run_DLList_sort_adaptive },
+	{ "DLList_sort_array", run_DLList_sort_array },
+	{ "DLList_sort_array relocate", run_DLList_sort_array_relocate },
+	{ "DLList_sort_radix", run_DLList_sort_radix },
+	{ "DLList_sort_parallel", run_DLList_sort_parallel },
+	{ NULL, NULL }
+};
+
+/*******************************************************************************
+	function to fill the input with one of the test patterns
+*******************************************************************************/
+
+static const char *fill (
+	void **in,
+	size_t n,
+	int pattern)
+{
+	const char *result = NULL;
+	size_t i;
+
+	srand (1);
+
+	for (i = 0; i < n; i++)
+		in[i] = (void *) (long) i;
+
+	switch (pattern) {
+		case 0:
+			result = "sorted";
+			break;
+
+		case 1:
+			result = "reversed";
+			for (i = 0; i < n; i++)
+				in[i] = (void *) (long) (n - i);
+			break;
+
+		case 2:
+			result = "nearly sorted";
+			for (i = 0; i < n / 100; i++)
+				in[rand () % n] = (void *) (long) (rand () % n);
+			break;
+
+		case 3:
+			result = "random";
+			for (i = 0; i < n; i++)
+				in[i] = (void *) (long) rand ();
+			break;
+	}
+
+	return result;
+}
+
+int main (
+	int argc,
+	char **argv)
+{
+	void **in = NULL;
+	const char *pattern = NULL;
+	size_t n = 1000000;
+	double seconds;
+	int p;
+	int i;
+
+	if (argc > 1)
+		n = strtoul (argv[1], NULL, 10);
+
+	if (argc > 2)
+		threads = strtoul (argv[2], NULL, 10);
+
+	if (!(in = malloc (n * sizeof (void *)))) {
+		fprintf (stderr, "out of memory\n");
+		return 1;
+	}
+
+	printf ("%-16s %-28s %14s %10s\n", "input", "sort", "compares", "seconds");
+
+	for (p = 0; (pattern = fill (in, n, p)); p++) {
+		for (i = 0; sorts[i].name; i++) {
+			seconds = sorts[i].run (in, n);
+
+			if (seconds < 0)
+				printf ("%-16s %-28s %14s\n", pattern, sorts[i].name, "NOT SORTED");
+			else if (compares == (size_t) -1)
+				printf ("%-16s %-28s %14s %10.3f\n", pattern, sorts[i].name, "-",
+								seconds);
+			else
+				printf ("%-16s %-28s %14lu %10.3f\n", pattern, sorts[i].name,
+								(unsigned long) compares, seconds);
+		}
+	}
+
+	free (in);
+
+	return 0;
+}
@@ -0,0 +1,301 @@
+/*******************************************************************************
+	bench_wsdeque.c
+
+	part of libLL
+
+	benchmark for the work stealing deque, a fork join sum that splits its
+	range in halves until the pieces are small, run by 1 to 8 workers that
+	each own a deque and steal when theirs is empty, against the same
+	workers sharing one deque behind a mutex
+
+	usage: bench_wsdeque [items [grain]]
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/time.h>
+#include "../include/DQLList.h"
+#include "../include/WSDeque.h"
+
+/***** the test settings *****/
+
+static unsigned long items = 1UL << 26;
+static unsigned long grain = 1024;
+
+/***** the workers *****/
+
+#define BENCH_WORKERS 8
+
+static WSDeque deques[BENCH_WORKERS];
+static DQLList shared;
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static int workers;
+
+/***** items not summed yet, and the sum *****/
+
+static volatile unsigned long remaining;
+static volatile unsigned long total;
+
+/***** a piece of the range *****/
+
+typedef struct {
+	unsigned long lo;
+	unsigned long hi;
+} bench_task;
+
+/*******************************************************************************
+	function to get the wall clock time in seconds
+*******************************************************************************/
+
+static double bench_time (void)
+{
+	struct timeval tv;
+
+	gettimeofday (&tv, NULL);
+
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/*******************************************************************************
+	function to do the work for a range, a few multiplies per item
+*******************************************************************************/
+
+static unsigned long bench_work (
+	unsigned long lo,
+	unsigned long hi)
+{
+	unsigned long result = 0;
+	unsigned long x;
+
+	for (; lo < hi; lo++) {
+		x = lo * 2654435761UL;
+		x ^= x >> 13;
+		x *= 2246822519UL;
+		result += x ^ (x >> 16);
+	}
+
+	return result;
+}
+
+/*******************************************************************************
+	function to make a task
+*******************************************************************************/
+
+static bench_task *bench_task_new (
+	unsigned long lo,
+	unsigned long hi)
+{
+	bench_task *result = malloc (sizeof (bench_task));
+
+	if (!result) {
+		fprintf (stderr, "out of memory\n");
+		exit (1);
+	}
+
+	result->lo = lo;
+	result->hi = hi;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to run a task, the right halves are forked onto the deque until
+	what is left is a grain, then it is summed
+
+	Arguments:
+				task	the task
+				self	the worker's deque, or NULL for the shared deque
+*******************************************************************************/
+
+static void bench_run_task (
+	bench_task *task,
+	WSDeque *self)
+{
+	unsigned long lo = task->lo;
+	unsigned long hi = task->hi;
+	unsigned long mid;
+
+	free (task);
+
+	while (hi - lo > grain) {
+		mid = lo + (hi - lo) / 2;
+		task = bench_task_new (mid, hi);
+
+		if (self)
+			WSDeque_push (self, task);
+
+		else {
+			pthread_mutex_lock (&mutex);
+			DQLList_push (&shared, task);
+			pthread_mutex_unlock (&mutex);
+		}
+
+		hi = mid;
+	}
+
+	__sync_fetch_and_add (&total, bench_work (lo, hi));
+	__sync_fetch_and_sub (&remaining, hi - lo);
+
+	return;
+}
+
+/*******************************************************************************
+	thread function for a worker with its own deque, it pops its own newest
+	task or steals the oldest task of a random other worker
+*******************************************************************************/
+
+static void *bench_stealer (
+	void *extra)
+{
+	int id = (int) (size_t) extra;
+	unsigned long seed = id + 1;
+	bench_task *task = NULL;
+	int victim;
+
+	while (remaining) {
+		if (!(task = WSDeque_pop (deques + id)) && workers > 1) {
+			seed = seed * 1103515245UL + 12345UL;
+			victim = (seed >> 16) % (workers - 1);
+			victim += victim >= id;
+			task = WSDeque_steal (deques + victim);
+		}
+
+		if (task)
+			bench_run_task (task, deques + id);
+		else
+			sched_yield ();
+	}
+
+	return NULL;
+}
+
+/*******************************************************************************
+	thread function for a worker using the shared deque
+*******************************************************************************/
+
+static void *bench_sharer (
+	void *extra)
+{
+	bench_task *task = NULL;
+
+	(void) extra;
+
+	while (remaining) {
+		task = NULL;
+
+		pthread_mutex_lock (&mutex);
+
+		if (shared.length)
+			task = DQLList_pop (&shared);
+
+		pthread_mutex_unlock (&mutex);
+
+		if (task)
+			bench_run_task (task, NULL);
+		else
+			sched_yield ();
+	}
+
+	return NULL;
+}
+
+/*******************************************************************************
+	function to run the sum with some workers, returns the seconds it took
+*******************************************************************************/
+
+static double bench_run (
+	int stealing,
+	int count,
+	unsigned long expect)
+{
+	pthread_t threads[BENCH_WORKERS];
+	bench_task *root = bench_task_new (0, items);
+	double start;
+	int i;
+
+	workers = count;
+	remaining = items;
+	total = 0;
+
+	if (stealing)
+		WSDeque_push (deques, root);
+	else
+		DQLList_push (&shared, root);
+
+	start = bench_time ();
+
+	for (i = 0; i < count; i++)
+		pthread_create (threads + i, NULL, stealing ? bench_stealer : bench_sharer,
+										(void *) (size_t) i);
+
+	for (i = 0; i < count; i++)
+		pthread_join (threads[i], NULL);
+
+	start = bench_time () - start;
+
+	if (total != expect)
+		fprintf (stderr, "wrong sum\n");
+
+	return start;
+}
+
+int main (
+	int argc,
+	char **argv)
+{
+	unsigned long expect;
+	double serial;
+	double stealing;
+	double locked;
+	int count;
+	int i;
+
+	if (argc > 1)
+		items = strtoul (argv[1], NULL, 10);
+
+	if (argc > 2)
+		grain = strtoul (argv[2], NULL, 10);
+
+	if (grain < 1)
+		grain = 1;
+
+	serial = bench_time ();
+	expect = bench_work (0, items);
+	serial = bench_time () - serial;
+
+	printf ("%lu items, grain %lu, serial %.3fs\n", items, grain, serial);
+	printf ("%8s %16s %16s\n", "workers", "WSDeque", "mutex DQLList");
+
+	for (count = 1; count <= BENCH_WORKERS; count *= 2) {
+		stealing = bench_run (1, count, expect);
+		locked = bench_run (0, count, expect);
+
+		printf ("%8d %8.3fs %5.2fx %8.3fs %5.2fx\n", count,
+						stealing, serial / stealing, locked, serial / locked);
+	}
+
+	for (i = 0; i < BENCH_WORKERS; i++)
+		WSDeque_delete_all (deques + i, NULL);
+
+	return 0;
+}
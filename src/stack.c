@@ -227,3 +227,97 @@ stackLList_node *stackLList_push_list_copy (
   
 	return result;
 }
+
+/*******************************************************************************
+	function to push the data in an array onto a stack
+
+	Arguments:
+				list	the linked list
+				array	the data you wish to store in the linked list
+				count	the number of entries in the array
+
+	returns:
+				0 on success
+				1 on error, nothing is pushed
+
+	notes:
+				the same as pushing each entry in turn, array[count - 1] ends up on
+				top
+
+*******************************************************************************/
+
+int stackLList_push_array (
+	stackLList * list,
+	void **array,
+	size_t count)
+{
+	int result;
+
+	result = SLList_prepend_array ((SLList *) list, array, count);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to copy the data in a stack to an array
+
+	Arguments:
+				list	the linked list
+				array	the array to fill, it must have room for the length of the
+							list
+
+	returns:
+				the number of entries filled in
+
+	notes:
+				the array is filled from the top down, the order the data would be
+				popped in
+
+*******************************************************************************/
+
+size_t stackLList_to_array (
+	stackLList * list,
+	void **array)
+{
+	size_t result;
+
+	result = SLList_to_array ((SLList *) list, array);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to copy another list to the head of a stack, all or nothing
+
+	Arguments:
+				dest		the linked list you want to copy the src to
+				src			the linked list you want to copy to the dest
+				copy_func	function to copy the data held in each node
+				free_func	function to free the copies made if a later one fails,
+										or NULL
+				arena		the arena to pass to copy_func, or NULL
+
+	returns:
+				0 on success
+				1 on error, nothing is added
+
+*******************************************************************************/
+
+int stackLList_push_list_copy_arena (
+	stackLList * dest,
+	stackLList * src,
+	stackLList_data_arena_copy_func copy_func,
+	stackLList_data_free_func free_func,
+	LLArena * arena)
+{
+	int result;
+
+	result = SLList_prepend_list_copy_arena (
+				(SLList *) dest,
+				(SLList *) src,
+				(SLList_data_arena_copy_func) copy_func,
+				(SLList_data_free_func) free_func,
+				arena);
+
+	return result;
+}
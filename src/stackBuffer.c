@@ -0,0 +1,406 @@
+/*******************************************************************************
+	stackBuffer.c
+
+	array backed stack
+
+	part of libLL
+
+  Copyright (C) 2005-2007  winkey
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU Library General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*******************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "../include/stackBuffer.h"
+
+/*******************************************************************************
+	slave function to make room for more items, doubling the buffer until
+	they fit
+
+	returns:
+				0 on success
+				1 on error
+*******************************************************************************/
+
+static int stackBuffer_grow (
+	stackBuffer *list,
+	size_t more)
+{
+	void **buffer = NULL;
+	size_t size = list->size ? list->size : STACKBUFFER_SIZE;
+
+	/***** too big to round up to a power of 2 and allocate *****/
+
+	if (more > SIZE_MAX / sizeof (void *) / 2 + 1 - list->length)
+		return 1;
+
+	while (size < list->length + more)
+		size <<= 1;
+
+	if (size == list->size)
+		return 0;
+
+	if (!(buffer = realloc (list->buffer, size * sizeof (void *))))
+		return 1;
+
+	list->buffer = buffer;
+	list->size = size;
+
+	return 0;
+}
+
+/*******************************************************************************
+	function to push data onto a stack
+
+	Arguments:
+				list	the stack
+				data	the data you wish to store in the stack
+
+	returns:
+				the data
+				NULL on error
+
+*******************************************************************************/
+
+void *stackBuffer_push (
+	stackBuffer * list,
+	void *data)
+{
+
+	if (list->length == list->size && stackBuffer_grow (list, 1))
+		return NULL;
+
+	list->buffer[list->length++] = data;
+
+	return data;
+}
+
+/*******************************************************************************
+	function to pop data from a stack
+
+	Arguments:
+				list	the stack
+
+	returns:
+				the data
+				NULL if the stack is empty
+
+*******************************************************************************/
+
+void *stackBuffer_pop (
+	stackBuffer * list)
+{
+	void *result = NULL;
+
+	if (list->length)
+		result = list->buffer[--list->length];
+
+	return result;
+}
+
+/*******************************************************************************
+	function to read the top of a stack without popping it
+
+	Arguments:
+				list	the stack
+
+	returns:
+				the data
+				NULL if the stack is empty
+
+*******************************************************************************/
+
+void *stackBuffer_read_head (
+	stackBuffer * list)
+{
+	void *result = NULL;
+
+	if (list->length)
+		result = list->buffer[list->length - 1];
+
+	return result;
+}
+
+/*******************************************************************************
+	function to count the items in a stack
+
+	Arguments:
+				list	the stack
+
+	returns:
+				the number of items in the stack
+
+*******************************************************************************/
+
+size_t stackBuffer_length (
+	stackBuffer * list)
+{
+	size_t result = list->length;
+
+	return result;
+}
+
+/*******************************************************************************
+	function to make room in a stack so it can hold a number of items without
+	growing
+
+	Arguments:
+				list	the stack
+				count	the number of items the stack must hold
+
+	returns:
+				0 on success
+				1 on error
+
+	notes:
+				the buffer is sized to exactly count, a workload that knows its
+				depth wastes nothing and never reallocates
+
+*******************************************************************************/
+
+int stackBuffer_reserve (
+	stackBuffer * list,
+	size_t count)
+{
+	void **buffer = NULL;
+
+	if (count <= list->size)
+		return 0;
+
+	if (count > SIZE_MAX / sizeof (void *))
+		return 1;
+
+	if (!(buffer = realloc (list->buffer, count * sizeof (void *))))
+		return 1;
+
+	list->buffer = buffer;
+	list->size = count;
+
+	return 0;
+}
+
+/*******************************************************************************
+	function to give back the slots a stack is not using
+
+	Arguments:
+				list	the stack
+
+	returns:
+				0 on success
+				1 on error, the buffer is left as it was
+
+*******************************************************************************/
+
+int stackBuffer_shrink (
+	stackBuffer * list)
+{
+	void **buffer = NULL;
+
+	if (list->length == list->size)
+		return 0;
+
+	if (!list->length) {
+		free (list->buffer);
+		list->buffer = NULL;
+		list->size = 0;
+
+		return 0;
+	}
+
+	if (!(buffer = realloc (list->buffer, list->length * sizeof (void *))))
+		return 1;
+
+	list->buffer = buffer;
+	list->size = list->length;
+
+	return 0;
+}
+
+/*******************************************************************************
+	function to iterate a stack from the top down
+
+	Arguments:
+				list 		the stack
+				function	the function to pass each item to for processing
+				extra		extra data to pass to/from the proccessing function
+
+	returns:
+				the non null returned from the proccessing function that stops the
+				iteration
+				NULL if the bottom of the stack was reached
+
+*******************************************************************************/
+
+void *stackBuffer_iterate (
+	stackBuffer * list,
+	stackBuffer_iterate_func function,
+	void *extra)
+{
+	void *result = NULL;
+	size_t i;
+
+	for (i = 0; i < list->length && !result; i++)
+		result = function (list, i, list->buffer[list->length - 1 - i], extra);
+
+	return result;
+}
+
+/*******************************************************************************
+	function to delete all the items in a stack and free its buffer
+
+	Arguments:
+				list		the stack
+				function	the function to call to free the data, or NULL
+
+	returns:
+				nothing
+
+*******************************************************************************/
+
+void stackBuffer_delete_all (
+	stackBuffer * list,
+	stackBuffer_data_free_func function)
+{
+	size_t i;
+
+	if (function) {
+		for (i = list->length; i > 0; i--)
+			function (list->buffer[i - 1]);
+	}
+
+	free (list->buffer);
+
+	list->buffer = NULL;
+	list->length = 0;
+	list->size = 0;
+
+	return;
+}
+
+/*******************************************************************************
+	function to move another stack to the top of a stack
+
+	Arguments:
+				dest	the stack you want to move the src to
+				src		the stack you want to move to the dest
+
+	returns:
+				0 on success
+				1 on error, nothing is moved
+
+	notes:
+				if the dest is empty the buffers are swapped and nothing is
+				copied
+
+*******************************************************************************/
+
+int stackBuffer_push_list (
+	stackBuffer * dest,
+	stackBuffer * src)
+{
+	void **buffer = NULL;
+	size_t size;
+
+	if (!src->length)
+		return 0;
+
+	if (!dest->length) {
+		buffer = dest->buffer;
+		size = dest->size;
+
+		dest->buffer = src->buffer;
+		dest->size = src->size;
+		dest->length = src->length;
+
+		src->buffer = buffer;
+		src->size = size;
+		src->length = 0;
+
+		return 0;
+	}
+
+	if (dest->length + src->length > dest->size &&
+			stackBuffer_grow (dest, src->length))
+		return 1;
+
+	memcpy (dest->buffer + dest->length, src->buffer,
+					src->length * sizeof (void *));
+
+	dest->length += src->length;
+	src->length = 0;
+
+	return 0;
+}
+
+/*******************************************************************************
+	function to push the data in an array onto a stack
+
+	Arguments:
+				list	the stack
+				array	the data you wish to store in the stack
+				count	the number of entries in the array
+
+	returns:
+				0 on success
+				1 on error, nothing is pushed
+
+*******************************************************************************/
+
+int stackBuffer_push_array (
+	stackBuffer * list,
+	void **array,
+	size_t count)
+{
+
+	if (!count)
+		return 0;
+
+	if (list->length + count > list->size && stackBuffer_grow (list, count))
+		return 1;
+
+	memcpy (list->buffer + list->length, array, count * sizeof (void *));
+	list->length += count;
+
+	return 0;
+}
+
+/*******************************************************************************
+	function to copy the data in a stack to an array
+
+	Arguments:
+				list	the stack
+				array	the array to fill, it must have room for the length of the
+							stack
+
+	returns:
+				the number of entries filled in
+
+*******************************************************************************/
+
+size_t stackBuffer_to_array (
+	stackBuffer * list,
+	void **array)
+{
+	size_t i;
+
+	for (i = 0; i < list->length; i++)
+		array[i] = list->buffer[list->length - 1 - i];
+
+	return i;
+}